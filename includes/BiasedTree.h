@@ -0,0 +1,92 @@
+#ifndef BIASEDTREE_H
+#define BIASEDTREE_H
+
+/**
+ * @file BiasedTree.h
+ *
+ * @author Zawarudo (@zawarudo)
+ *
+ * @brief A header file for biased auxiliary trees, an alternative to the red-black auxiliary trees of the Tango Tree
+ * that keeps the frequently accessed keys of a preferred path near its root. A biased tree is a treap whose node
+ * priorities are the decayed access counts of the keys (the node heat), with a hash of the key breaking ties so that
+ * a path of cold keys is a random treap, balanced in expectation. It supports the split, join and depth aggregate
+ * contract of the auxiliary trees (see AuxiliaryTree).
+ *
+ * @version 1.0
+ * @date 2026-10-18
+ */
+
+// includes.
+#include "RedBlackTree.h"
+
+extern const AuxiliaryTree BiasedAuxiliary;     // The biased auxiliary trees.
+
+/**
+ * @brief Joins two biased trees and a node into a single biased tree. The node with the highest priority of the three
+ * roots becomes the root, and the join continues in the subtree on the side of the other two.
+ *
+ * @param leftTree The root of the left tree, an external node if it is empty.
+ * @param x The middle node.
+ * @param rightTree The root of the right tree, an external node if it is empty.
+ * @return The root of the joined tree.
+ * @note Precondition: All the keys in the left tree must be smaller than the key in the given node. All the keys in the
+ * right tree must be greater than the key in the given node.
+ * @note Time Complexity: O(h1 + h2), where h1 and h2 are the heights of the right spine of the left tree and the left
+ * spine of the right tree.
+ */
+Node *biasedJoin(Node *leftTree, Node *x, Node *rightTree);
+
+/**
+ * @brief Splits the given biased tree around the node with the given key.
+ *
+ * @param h The tree root.
+ * @param key The splitter key.
+ * @return A tuple containing the left tree, the node with the given key and the right tree.
+ * @note Precondition: The key must exist in the tree.
+ * @note Time Complexity: O(depth of the key).
+ */
+std::tuple<Node *, Node *, Node *> biasedSplit(Node *h, int key);
+
+/**
+ * @brief Removes the node with the min key from the given biased tree.
+ *
+ * @param root The tree root.
+ * @return The min node and the new tree root.
+ * @note Precondition: The tree must not be empty.
+ * @note Time Complexity: O(depth of the min key).
+ */
+std::pair<Node *, Node *> biasedDeleteMin(Node *root);
+
+/**
+ * @brief Removes the node with the max key from the given biased tree.
+ *
+ * @param root The tree root.
+ * @return The max node and the new tree root.
+ * @note Precondition: The tree must not be empty.
+ * @note Time Complexity: O(depth of the max key).
+ */
+std::pair<Node *, Node *> biasedDeleteMax(Node *root);
+
+/**
+ * @brief Records an access to the given key: its heat grows by one and its node is rotated up while its priority is
+ * higher than its parent's.
+ *
+ * @param root The tree root.
+ * @param key The accessed key.
+ * @return The new tree root.
+ * @note Precondition: The key must exist in the tree.
+ * @note Time Complexity: O(depth of the key).
+ */
+Node *biasedTouch(Node *root, int key);
+
+/**
+ * @brief Halves the heat of every node of the given tree, following the external nodes, so that old accesses weigh less
+ * than recent ones. Halving keeps the heat order between the nodes, up to the ties it creates. Cold stubs and subtrees
+ * shared with a fork are skipped.
+ *
+ * @param h The tree root.
+ * @note Time Complexity: O(n).
+ */
+void decay(Node *h);
+
+#endif     // BIASEDTREE_H
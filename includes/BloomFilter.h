@@ -0,0 +1,72 @@
+#ifndef BLOOMFILTER_H
+#define BLOOMFILTER_H
+
+/**
+ * @file BloomFilter.h
+ *
+ * @author Zawarudo (@zawarudo)
+ *
+ * @brief A header file for a blocked Bloom filter over integer keys, used by the Tango Tree to reject absent keys
+ * before searching. The filter is split in 512-bit blocks (one cache line) and every key sets one bit in each of the
+ * eight 64-bit words of a single block, so a query reads one cache line and never reports a false negative.
+ *
+ * @version 1.0
+ * @date 2026-10-18
+ */
+
+// includes.
+#include <cstdint>
+#include <vector>
+
+/**
+ * @brief A class representing a blocked Bloom filter. Keys can be added but not removed; a query answers either "maybe
+ * present" or "surely absent".
+ */
+class BloomFilter {
+private:
+  std::vector<uint64_t> words;     // The filter bits, eight consecutive words per block.
+  int capacity;                    // The number of keys the filter was sized for.
+
+public:
+  /**
+   * @brief Construct a new Bloom Filter object sized for the given number of keys.
+   *
+   * @param n The expected number of keys.
+   * @param bitsPerKey The number of filter bits per key. 0 builds an empty filter that rejects every key.
+   */
+  BloomFilter(int n = 0, int bitsPerKey = 0);
+
+  /**
+   * @brief Adds the given key to the filter.
+   *
+   * @param key The key to add.
+   * @note Precondition: The filter must not be empty.
+   * @note Time Complexity: O(1).
+   */
+  void add(int key);
+
+  /**
+   * @brief Checks if the given key may be in the filter.
+   *
+   * @param key The key to check.
+   * @return false if the key was surely never added, true otherwise.
+   * @note Time Complexity: O(1), one cache line read.
+   */
+  bool mayContain(int key) const;
+
+  /**
+   * @brief Returns the number of keys the filter was sized for. Adding many more keys raises the false positive rate.
+   *
+   * @return The filter capacity.
+   */
+  int size() const { return capacity; }
+
+  /**
+   * @brief Checks if the filter has no bits (built with 0 bits per key).
+   *
+   * @return true if the filter is empty, false otherwise.
+   */
+  bool empty() const { return words.empty(); }
+};
+
+#endif     // BLOOMFILTER_H
@@ -0,0 +1,215 @@
+#ifndef CONCURRENTREDBLACKTREE_H
+#define CONCURRENTREDBLACKTREE_H
+
+/**
+ * @file ConcurrentRedBlackTree.h
+ *
+ * @author Zawarudo (@zawarudo)
+ *
+ * @brief A header file for a left-leaning red-black tree shared by many threads, for the standalone use of the red-black
+ * tree as an ordered index. Readers never lock: every node carries a version, odd while a writer changes its children,
+ * and a search validates the version of each node after reading its child (optimistic lock coupling), restarting when
+ * a writer changed the path under it. Writers take a writer lock, so there is one at a time, and lock for the readers
+ * only the nodes whose children they change, from the first change to the end of the operation: a search off the
+ * rebalanced nodes is never delayed.
+ *
+ * Removed nodes are released once every search that may still hold them has finished: searches register in one of two
+ * epochs, on per-thread counters, and a writer that removed enough nodes flips the epoch and waits for the older one.
+ *
+ * @version 1.0
+ * @date 2026-10-18
+ */
+
+// includes.
+#include "RedBlackTree.h"
+#include <atomic>
+#include <mutex>
+#include <tuple>
+#include <vector>
+
+// defines.
+#define READER_SLOTS 64     // number of reader counters per epoch, each on its own cache line.
+
+/**
+ * @brief A class representing a concurrent red-black tree of integer keys. insert and deleteMin can be called from any
+ * thread, concurrently with any number of contains calls.
+ */
+class ConcurrentRedBlackTree {
+private:
+  /**
+   * @brief A node of the concurrent tree. The key and color are only written before the node is published and by the
+   * writer holding the writer lock, the children are atomic so that searches read them while a writer changes them.
+   */
+  struct Node {
+    const int key;                         // The node key.
+    Color color;                           // The node color, only read by writers.
+    std::atomic<unsigned long> version;    // The node version, odd while a writer changes the children.
+    std::atomic<Node *> left;              // The left child, nullptr for none.
+    std::atomic<Node *> right;             // The right child, nullptr for none.
+
+    // Constructor.
+    Node(int k) : key(k), color(RED), version(0), left(nullptr), right(nullptr) {}
+  };
+
+  /**
+   * @brief A reader counter, alone on its cache line so that searches from different threads do not share one.
+   */
+  struct alignas(64) Counter {
+    std::atomic<long> n{0};     // The number of searches registered on the counter.
+  };
+
+  std::atomic<Node *> root;                 // The tree root, nullptr for an empty tree.
+  std::atomic<unsigned long> rootVersion;   // The version of the root pointer, as a node version.
+  std::atomic<long> count;                  // The number of keys in the tree.
+
+  std::mutex writer;                                  // The writer lock.
+  std::vector<std::atomic<unsigned long> *> locked;   // The versions locked by the current writer.
+  std::vector<Node *> retired;                        // The nodes removed by the writers, not released yet.
+
+  std::atomic<unsigned> epoch;                 // The current reader epoch.
+  mutable Counter readers[2][READER_SLOTS];    // The number of searches in flight, per epoch parity and slot.
+
+  /**
+   * @brief Registers a search in the current epoch.
+   *
+   * @return The counter of the search, to be decremented when it finishes.
+   */
+  std::atomic<long> &enter() const;
+
+  /**
+   * @brief Waits until every search registered before the call has finished, and releases the retired nodes.
+   */
+  void reclaim();
+
+  /**
+   * @brief Searches the key once, without registering.
+   *
+   * @param key The key to search for.
+   * @return 1 if the key is in the tree, 0 if it is not, and -1 if a writer changed the path and the search must
+   * restart.
+   */
+  int tryContains(int key) const;
+
+  /**
+   * @brief Locks the given version for the current writer, if it is not locked already.
+   *
+   * @param version The version of a node or of the root pointer.
+   */
+  void lock(std::atomic<unsigned long> &version);
+
+  /**
+   * @brief Unlocks every version locked by the current writer, making its changes visible to the searches as a whole.
+   */
+  void unlockAll();
+
+  /**
+   * @brief Sets a child of the given node, locking the node if the child changes.
+   *
+   * @param h The node.
+   * @param child The left or right child field of h.
+   * @param x The new child.
+   */
+  void setChild(Node *h, std::atomic<Node *> &child, Node *x);
+
+  /**
+   * @brief Rotates a subtree to the left, as the red-black tree rotateLeft does, locking the two nodes.
+   *
+   * @param h The subtree root. Its right child must be red.
+   * @return The new subtree root.
+   */
+  Node *rotateLeft(Node *h);
+
+  /**
+   * @brief Rotates a subtree to the right, as the red-black tree rotateRight does, locking the two nodes.
+   *
+   * @param h The subtree root. Its left child must be red.
+   * @return The new subtree root.
+   */
+  Node *rotateRight(Node *h);
+
+  /**
+   * @brief Fixes the local red-black violations at the given node, as the red-black tree balance does.
+   *
+   * @param h The subtree root.
+   * @return The new subtree root.
+   */
+  Node *balance(Node *h);
+
+  /**
+   * @brief Recursive insert method, see the red-black tree insert.
+   *
+   * @param h The subtree root.
+   * @param key The key to insert.
+   * @param inserted Set to true if the key was not in the subtree.
+   * @return The new subtree root.
+   */
+  Node *insertRec(Node *h, int key, bool &inserted);
+
+  /**
+   * @brief Fixes the given node after its left subtree lost one black node, see the red-black tree popFront.
+   *
+   * @param h The node whose left subtree is short.
+   * @return The new subtree root and whether the subtree is still short of one black node.
+   */
+  std::pair<Node *, bool> fixShortLeft(Node *h);
+
+  /**
+   * @brief Recursive bottom-up min removal method, see the red-black tree popFront.
+   *
+   * @param h The subtree root, not nullptr.
+   * @return The min node, the new subtree root and whether the subtree is short of one black node.
+   */
+  std::tuple<Node *, Node *, bool> deleteMinRec(Node *h);
+
+public:
+  /**
+   * @brief Construct a new empty Concurrent Red Black Tree object.
+   */
+  ConcurrentRedBlackTree();
+
+  /**
+   * @brief Destroy the Concurrent Red Black Tree object, releasing all its nodes. No operation may be in flight.
+   */
+  ~ConcurrentRedBlackTree();
+
+  ConcurrentRedBlackTree(const ConcurrentRedBlackTree &) = delete;               // The tree is shared by address.
+  ConcurrentRedBlackTree &operator=(const ConcurrentRedBlackTree &) = delete;
+
+  /**
+   * @brief Checks if the tree contains the given key, without taking any lock.
+   *
+   * @param key The key to search for.
+   * @return true if the key is in the tree, false otherwise.
+   * @note Time Complexity: O(log(n)), plus the restarts caused by writers changing the search path.
+   */
+  bool contains(int key) const;
+
+  /**
+   * @brief Inserts the given key.
+   *
+   * @param key The key to insert.
+   * @return true if the key was inserted, false if it was already in the tree.
+   * @note Time Complexity: O(log(n)), once the writer lock is taken.
+   */
+  bool insert(int key);
+
+  /**
+   * @brief Removes the min key. The node is removed bottom-up as popFront does, so only the nodes near the bottom of the
+   * left spine are usually locked.
+   *
+   * @param key Set to the removed key.
+   * @return true if a key was removed, false if the tree is empty.
+   * @note Time Complexity: O(log(n)), once the writer lock is taken, plus the wait for the searches in flight once
+   * every few removals.
+   */
+  bool deleteMin(int &key);
+
+  /**
+   * @brief Returns the number of keys in the tree.
+   *
+   * @return The tree size.
+   */
+  long size() const { return count.load(std::memory_order_relaxed); }
+};
+
+#endif     // CONCURRENTREDBLACKTREE_H
@@ -0,0 +1,66 @@
+#ifndef KEYFILE_H
+#define KEYFILE_H
+
+/**
+ * @file KeyFile.h
+ *
+ * @author Zawarudo (@zawarudo)
+ *
+ * @brief A header file for a read-only, memory mapped key file. A key file is a raw array of 32-bit integers in the host
+ * byte order, sorted in increasing order and without duplicates, so that the tree builders can read it in place: no
+ * parsing and no copy, and the load time is bounded by the memory bandwidth.
+ *
+ * @version 1.0
+ * @date 2026-10-18
+ */
+
+// includes.
+#include <cstddef>
+
+/**
+ * @brief A class representing a key file mapped into memory. The mapping is released with the object.
+ */
+class KeyFile {
+private:
+  const int *keys;   // The mapped keys, nullptr when no file is mapped.
+  size_t n;          // The number of keys.
+
+public:
+  /**
+   * @brief Construct a new Key File object, with no file mapped.
+   */
+  KeyFile() : keys(nullptr), n(0) {}
+
+  /**
+   * @brief Destroy the Key File object, unmapping the file.
+   */
+  ~KeyFile();
+
+  KeyFile(const KeyFile &) = delete;               // A key file owns its mapping, it can not be copied.
+  KeyFile &operator=(const KeyFile &) = delete;
+
+  /**
+   * @brief Maps the given key file, replacing the current one.
+   *
+   * @param path The file path.
+   * @return true if the file was mapped and holds at most INT_MAX sorted keys without duplicates, false otherwise.
+   * @note Time Complexity: O(n) to check the key order, one sequential pass over the file.
+   */
+  bool open(const char *path);
+
+  /**
+   * @brief Returns the mapped keys.
+   *
+   * @return A pointer to the first key.
+   */
+  const int *data() const { return keys; }
+
+  /**
+   * @brief Returns the number of mapped keys.
+   *
+   * @return The number of keys.
+   */
+  size_t size() const { return n; }
+};
+
+#endif     // KEYFILE_H
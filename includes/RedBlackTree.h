@@ -16,6 +16,8 @@
  */
 
 // includes.
+#include <cstddef>
+#include <iosfwd>
 #include <tuple>
 
 // defines.
@@ -25,9 +27,10 @@
 /**
  * @brief Enum to encode the color of a node in the red-black tree. A node color can be either RED or BLACK.
  *
- * @note Using a boolean would improve memory efficiency; however, we opted for an enum to ensure the code remains readable and self-explanatory.
+ * @note Using a boolean would not improve memory efficiency, since the enum is one byte wide; we opted for an enum to ensure the code remains readable and
+ * self-explanatory.
  */
-enum Color { RED, BLACK };
+enum Color : unsigned char { RED, BLACK };
 
 /**
  * @brief Struct to represent a node in a red-black tree. Each node contains, at least, an integer key, pointers to the left and right children, and a color
@@ -38,11 +41,16 @@ enum Color { RED, BLACK };
  */
 struct Node {
   int key;     // The node key value. For simplicity we use an integer key, but it could be templated to support any comparable type.
+  unsigned refs;     // The number of tango trees sharing the auxiliary tree rooted at the node, after a fork (1 otherwise).
 
   Node *left;      // The left child pointer.
   Node *right;     // The right child pointer.
   Color color;     // The node color (RED or BLACK).
 
+  unsigned short heat;     // The decayed access count of the key, the priority of the node in a biased auxiliary tree.
+
+  int size;     // The number of keys in the subtree, erased keys excluded. In a tango tree it counts the keys below external nodes too.
+
   short blackHeight;     // Black height of the node in the red-black tree. Since a tree with n nodes has height at most 2*log(n), we can use a short to store
                          // the black height, which is more memory efficient than using an integer.
 
@@ -52,13 +60,57 @@ struct Node {
   short minDepth;      // The subtree min depth in the reference tree.
   short maxDepth;      // The subtree max depth in the reference tree.
   bool isExternal;     // Flag to indicate if the node is an external node (nil or another tree root).
+  bool isDeleted;      // Flag to indicate if the key was erased from the tango tree (the node stays as a tombstone).
+  bool hasValue;       // Flag to indicate if the node is a MapNode, carrying a value and a value aggregate.
+  bool isCold;         // Flag to indicate if the node is a compressed external subtree of a tango tree.
+  unsigned stamp;      // The tango tree access count when the node last became the root of an external subtree.
 
   static Node *nil;     // Static pointer to the nil node, shared among all nodes instances.
 
   // Constructor.
-  Node(int k) : key(k), left(nullptr), right(nullptr), color(RED), blackHeight(0), depth(0), minDepth(0), maxDepth(0), isExternal(false) {}
+  Node(int k)
+      : key(k), refs(1), left(nullptr), right(nullptr), color(RED), heat(0), size(1), blackHeight(0), depth(0), minDepth(0), maxDepth(0), isExternal(false), isDeleted(false), hasValue(false),
+        isCold(false), stamp(0) {}
+};
+
+/**
+ * @brief Struct to represent an associative operation with an identity element (a monoid) over the node values, such as
+ * sum, min or max. The aggregate of a subtree is the combination of its values in key order, so the operation does not
+ * need to be commutative.
+ */
+struct Monoid {
+  long long identity;                              // The identity element: combine(identity, x) = combine(x, identity) = x.
+  long long (*combine)(long long, long long);     // The associative operation.
+};
+
+/**
+ * @brief Struct to represent a node that maps its key to a value. Besides the node fields, it keeps the aggregate of the
+ * values in its subtree, maintained by update() through rotations, splits and joins like the other subtree fields. All
+ * the nodes of a tree must be map nodes with the same monoid, or none of them.
+ */
+struct MapNode : Node {
+  long long value;          // The value mapped to the key.
+  long long agg;            // The aggregate of the values in the subtree, erased keys excluded.
+  const Monoid *monoid;     // The monoid of the aggregate.
+
+  // Constructor.
+  MapNode(int k, long long v, const Monoid *m) : Node(k), value(v), agg(v), monoid(m) { hasValue = true; }
 };
 
+/**
+ * @brief Struct to represent the operations of the auxiliary trees of a tango tree: the binary search trees holding the
+ * preferred paths. Besides keeping the keys in order, split and join must leave the subtree fields of the touched nodes
+ * up to date (see update), and treat every external node as an empty tree.
+ */
+struct AuxiliaryTree {
+  Node *(*join)(Node *, Node *, Node *);                        // Joins two trees and a middle node, see join.
+  std::tuple<Node *, Node *, Node *> (*split)(Node *, int);     // Splits a tree around a key, see split.
+  std::pair<Node *, Node *> (*deleteMin)(Node *);               // Removes the min node of a tree, see deleteMin.
+  std::pair<Node *, Node *> (*deleteMax)(Node *);               // Removes the max node of a tree, see deleteMax.
+};
+
+extern const AuxiliaryTree RedBlackAuxiliary;     // The red-black auxiliary trees, balanced whatever the accesses.
+
 // Red-Black Tree methods. //
 
 /**
@@ -73,6 +125,25 @@ struct Node {
  */
 Node *newNode(int key, int depth = 0);
 
+/**
+ * @brief Create a new map node with the given key, value and depth, initialized like newNode.
+ *
+ * @param key The new node key value.
+ * @param value The value mapped to the key.
+ * @param monoid The monoid of the tree aggregate. It must outlive the node.
+ * @param depth The node depth (used in the tango tree construction)
+ * @return A pointer to the newly created node.
+ * @note Time Complexity: O(1).
+ */
+Node *newMapNode(int key, long long value, const Monoid *monoid, int depth = 0);
+
+/**
+ * @brief Releases the given node, created by newNode or newMapNode.
+ *
+ * @param x The node.
+ */
+void deleteNode(Node *x);
+
 /**
  * @brief Search for a node with a given key in the red-black tree. It returns a pointer to the node and it's parent if found it, or an external node and the
  * last visited node otherwise.
@@ -84,6 +155,28 @@ Node *newNode(int key, int depth = 0);
  */
 std::pair<Node *, Node *> search(Node *root, int key);
 
+/**
+ * @brief Builds a red-black tree over the given sorted keys. The two halves around the middle key are built recursively,
+ * in parallel for large inputs, and joined with it; since their heights differ by at most one, each join is O(1).
+ *
+ * @param keys The keys, sorted in increasing order and without duplicates.
+ * @param n The number of keys.
+ * @return The tree root.
+ * @note Time Complexity: O(n).
+ */
+Node *build(const int *keys, size_t n);
+
+/**
+ * @brief Builds a red-black tree over the given nodes, reusing them, like build does over keys. The red-black and depth
+ * fields of the nodes are reset, so they can come from another structure, such as a tango tree.
+ *
+ * @param nodes The nodes, sorted by key, without duplicates.
+ * @param n The number of nodes.
+ * @return The tree root.
+ * @note Time Complexity: O(n).
+ */
+Node *build(Node *const *nodes, size_t n);
+
 /**
  * @brief Inserts a key into the given red-black tree.
  *
@@ -142,6 +235,29 @@ std::pair<Node *, Node*> deleteMin(Node *root);
  */
 std::pair<Node *, Node*> deleteMax(Node *root);
 
+/**
+ * @brief Appends a key greater than every key in the tree, the insert of a sliding window. The new node is attached at the bottom of the right spine without
+ * comparing keys, and the rotations and color flips stop at the first level that absorbs it.
+ *
+ * @param root The tree root.
+ * @param key The key to append.
+ * @return The new tree root.
+ * @note Precondition: The key must be greater than every key in the tree.
+ * @note Time Complexity: O(1) amortized restructuring over a run of appends, plus O(log(N)) subtree size updates along the right spine.
+ */
+Node *pushBack(Node *root, int key);
+
+/**
+ * @brief Removes the node with the min key, the delete of a sliding window. Unlike deleteMin, which moves red links down the whole left spine before removing
+ * the node, the tree is fixed bottom-up from the removed leaf, and the fix stops at the first level that absorbs the missing black node.
+ *
+ * @param root The tree root.
+ * @return The min node and the new tree root.
+ * @note Precondition: The tree must be non-empty.
+ * @note Time Complexity: O(1) amortized restructuring over a run of removals, plus O(log(N)) subtree size updates along the left spine.
+ */
+std::pair<Node *, Node *> popFront(Node *root);
+
 /**
  * @brief Returns the minimum key value in the given subtree.
  *
@@ -161,6 +277,51 @@ Node *min(Node *root);
  */
 Node *max(Node *root);
 
+/**
+ * @brief Returns the rank of the given key in the given tree: the number of keys in the tree smaller than the key. The key
+ * does not need to be in the tree.
+ *
+ * @param root The tree root.
+ * @param key The key.
+ * @return The number of keys smaller than the given key.
+ * @note Time Complexity: O(log(N)), where N is the number of nodes in the subtree.
+ */
+int rank(Node *root, int key);
+
+/**
+ * @brief Returns the node with the given rank in the given tree, the i-th smallest key counting from 0.
+ *
+ * @param root The tree root.
+ * @param i The rank.
+ * @return The node with rank i, or the nil node if i is not in [0, size).
+ * @note Time Complexity: O(log(N)), where N is the number of nodes in the subtree.
+ */
+Node *select(Node *root, int i);
+
+/**
+ * @brief Splits the given red-black tree around the node with the given rank. The first tree contains the i smallest keys
+ * and the second one the keys greater than the key with rank i.
+ *
+ * @param h The subtree root.
+ * @param i The rank of the splitter node.
+ * @return A tuple containing the left tree, the node with rank i, and the right tree.
+ * @note Precondition: i must be in [0, size).
+ * @note Time Complexity: O(log(N)), where N is the number of nodes in the subtree.
+ */
+std::tuple<Node *, Node *, Node *> splitAtRank(Node *h, int i);
+
+/**
+ * @brief Returns the aggregate of the values with keys in [lo, hi] in the given tree of map nodes.
+ *
+ * @param root The tree root.
+ * @param lo The lower bound of the key range.
+ * @param hi The upper bound of the key range.
+ * @param monoid The tree monoid.
+ * @return The combination, in key order, of the values in the range, or the monoid identity if the range is empty.
+ * @note Time Complexity: O(log(N)), where N is the number of nodes in the subtree.
+ */
+long long aggregate(Node *root, int lo, int hi, const Monoid &monoid);
+
 /**
  * @brief Prints the given red-black tree.
  *
@@ -168,6 +329,14 @@ Node *max(Node *root);
  */
 void print(Node *root);
 
+/**
+ * @brief Prints the given red-black tree to the given stream.
+ *
+ * @param root The tree root.
+ * @param out The output stream.
+ */
+void print(Node *root, std::ostream &out);
+
 /**
  * @brief Updates the given node fields based on its children.
  *
@@ -176,4 +345,37 @@ void print(Node *root);
  */
 void update(Node *h);
 
+/**
+ * @brief Returns the number of recursion levels that split an O(n) construction of n keys between threads, enough to use
+ * every hardware thread. Small inputs are built on the calling thread.
+ *
+ * @param n The number of keys.
+ * @return The number of levels.
+ */
+int spawnLevels(size_t n);
+
+/**
+ * @brief Sets the minimum number of keys for the O(n) constructions to use more than one thread, for the whole process.
+ * The best value depends on the cost of starting a thread on the host, see calibrate in TangoTune.h.
+ *
+ * @param n The number of keys, 0 restores the default.
+ */
+void setParallelCutoff(size_t n);
+
+/**
+ * @brief Returns the minimum number of keys for the O(n) constructions to use more than one thread.
+ *
+ * @return The number of keys.
+ */
+size_t parallelCutoff();
+
+/**
+ * @brief Updates the subtree size and, for a map node, the value aggregate of the given node based on its children.
+ * Unlike update, it leaves the red-black and depth fields alone, so it also applies to external nodes.
+ *
+ * @param h The node.
+ * @note Time Complexity: O(1)
+ */
+void augment(Node *h);
+
 #endif     // REDBLACKTREE_H
\ No newline at end of file
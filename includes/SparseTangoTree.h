@@ -0,0 +1,116 @@
+#ifndef SPARSETANGOTREE_H
+#define SPARSETANGOTREE_H
+
+/**
+ * @file SparseTangoTree.h
+ *
+ * @author Zawarudo (@zawarudo)
+ *
+ * @brief A header file for a sparse key front-end to the Tango Tree. The implicit Tango Tree over the keys 1 to n is its
+ * most compact form, with the reference depth of a key computable from its value. Real keys, however, are often sparse
+ * 64-bit IDs. The front-end maps each key to its rank (its position among the sorted keys) in O(1) with a minimal
+ * perfect hash and a rank table, and runs the accesses on the implicit tree over the ranks.
+ *
+ * The minimal perfect hash follows the hash-and-displace scheme: keys are grouped in small buckets, and each bucket,
+ * from the largest to the smallest, gets the first displacement that sends all its keys to free slots. A lookup hashes
+ * the key once to find its bucket, and once more with the bucket displacement to find its slot.
+ *
+ * @version 1.0
+ * @date 2026-10-18
+ */
+
+// includes. //
+#include "TangoTree.h"
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+/**
+ * @brief A class representing a static map from a set of 64-bit keys to their ranks, 1 for the smallest key up to n for
+ * the largest one. It stores the sorted keys (to reject the keys outside the set), one 32-bit displacement per bucket
+ * of about four keys and one 32-bit rank per key.
+ */
+class RankMap {
+private:
+  std::vector<uint64_t> keys;            // The keys, sorted in increasing order.
+  std::vector<uint32_t> displacements;   // The displacement of each bucket.
+  std::vector<int> ranks;                // The rank of the key hashed to each slot.
+
+  /**
+   * @brief Returns the slot of the given key, a position in [0, n) that is unique for each key in the set.
+   *
+   * @param key The key.
+   * @return The key slot.
+   */
+  size_t slot(uint64_t key) const;
+
+public:
+  /**
+   * @brief Construct a new Rank Map object over the given keys.
+   *
+   * @param keys The keys, in any order. Duplicates are ignored.
+   * @note Time Complexity: O(n log(n)) expected.
+   */
+  RankMap(std::vector<uint64_t> keys);
+
+  /**
+   * @brief Returns the rank of the given key.
+   *
+   * @param key The key.
+   * @return The key rank (1 to n), or 0 if the key is not in the set.
+   * @note Time Complexity: O(1).
+   */
+  int rank(uint64_t key) const;
+
+  /**
+   * @brief Returns the key with the given rank.
+   *
+   * @param r The rank, from 1 to n.
+   * @return The key with rank r.
+   */
+  uint64_t key(int r) const { return keys[r - 1]; }
+
+  /**
+   * @brief Returns the number of keys in the set.
+   *
+   * @return The set size.
+   */
+  int size() const { return keys.size(); }
+};
+
+/**
+ * @brief A class representing a Tango Tree over a sparse set of 64-bit keys. Each access maps the key to its rank with
+ * a RankMap and searches the rank in an implicit Tango Tree over 1 to n, so the adaptive behaviour is the one of a Tango
+ * Tree over the keys themselves.
+ */
+class SparseTangoTree {
+private:
+  RankMap map;      // The key to rank map.
+  TangoTree tree;   // The implicit Tango Tree over the ranks.
+
+public:
+  /**
+   * @brief Construct a new Sparse Tango Tree object over the given keys.
+   *
+   * @param keys The keys, in any order. Duplicates are ignored.
+   */
+  SparseTangoTree(const std::vector<uint64_t> &keys);
+
+  /**
+   * @brief Checks if the tree contains the given key. A key outside the set is rejected by the rank map without
+   * touching the tree; a key in the set is accessed through its rank.
+   *
+   * @param key The key to search for.
+   * @return true if the key is in the tree, false otherwise.
+   */
+  bool contains(uint64_t key);
+
+  /**
+   * @brief Returns the number of keys in the tree.
+   *
+   * @return The tree size.
+   */
+  int size() const { return map.size(); }
+};
+
+#endif     // SPARSETANGOTREE_H
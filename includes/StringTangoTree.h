@@ -0,0 +1,97 @@
+#ifndef STRINGTANGOTREE_H
+#define STRINGTANGOTREE_H
+
+/**
+ * @file StringTangoTree.h
+ *
+ * @author Zawarudo (@zawarudo)
+ *
+ * @brief A header file for a string key front-end to the Tango Tree. A string comparison has to follow a pointer to the
+ * characters, which costs a cache miss per comparison on large tables. Each key here is paired with an inline 8-byte
+ * normalized prefix: its 8 bytes following the leading bytes shared by every key, read as a big-endian integer, zero
+ * padded. Two prefixes compare like the strings they come from, so a search compares the prefixes first and reads the
+ * characters only on a tie. Skipping the shared bytes matters for URL and path keys, which often all start with the
+ * same scheme and host: their first 8 bytes would tie on every comparison.
+ *
+ * The tree is a Tango Tree over the key ranks whose nodes are map nodes, with the prefix of their key in place of the
+ * value. A search goes down the tree's own nodes comparing the inline prefixes, so the nodes the tree keeps near the
+ * top are the ones a search reads, and the found rank is then accessed for the tree to adapt.
+ *
+ * @version 1.0
+ * @date 2026-10-18
+ */
+
+// includes.
+#include "TangoTree.h"
+#include <cstdint>
+#include <string>
+#include <vector>
+
+/**
+ * @brief A class representing a Tango Tree over a set of string keys.
+ */
+class StringTangoTree : private TangoTree {
+private:
+  std::string common;              // The leading bytes shared by every key, skipped by the prefixes.
+  std::vector<std::string> keys;   // The keys, sorted in increasing order.
+
+  /**
+   * @brief Construct a new String Tango Tree object over the given sorted keys.
+   *
+   * @param sorted The keys, sorted and without duplicates.
+   */
+  StringTangoTree(std::vector<std::string> &&sorted, int);
+
+  /**
+   * @brief Returns the rank of the given key, going down the tree nodes and comparing their inline prefixes, and the
+   * full strings only on a prefix tie. A key that does not start with the common bytes is rejected right away.
+   *
+   * @param key The key.
+   * @return The key rank (1 to n), or 0 if the key is not in the set.
+   * @note Time Complexity: O(depth of the key in the tree) prefix comparisons, plus the full comparisons with the keys
+   * sharing the prefix on the way.
+   */
+  int rank(const std::string &key) const;
+
+public:
+  /**
+   * @brief Construct a new String Tango Tree object over the given keys.
+   *
+   * @param keys The keys, in any order. Duplicates are ignored.
+   */
+  StringTangoTree(std::vector<std::string> keys);
+
+  /**
+   * @brief Checks if the tree contains the given key. The key is accessed in the tree through its rank.
+   *
+   * @param key The key to search for.
+   * @return true if the key is in the tree, false otherwise.
+   */
+  bool contains(const std::string &key);
+
+  /**
+   * @brief Returns the number of keys in the tree.
+   *
+   * @return The tree size.
+   */
+  int size() const { return TangoTree::size(); }
+
+  /**
+   * @brief Returns the leading bytes shared by every key, which the prefixes skip.
+   *
+   * @return The common leading bytes.
+   */
+  const std::string &commonPrefix() const { return common; }
+};
+
+/**
+ * @brief Returns the normalized prefix of the given string: its 8 bytes from the given offset as a big-endian integer,
+ * zero padded. For any two strings a and b sharing their first offset bytes, a < b implies prefix(a) <= prefix(b).
+ *
+ * @param s The string.
+ * @param offset The number of leading bytes to skip.
+ * @return The string prefix.
+ */
+uint64_t normalizedPrefix(const std::string &s, size_t offset = 0);
+
+#endif     // STRINGTANGOTREE_H
@@ -0,0 +1,87 @@
+#ifndef TANGOMAP_H
+#define TANGOMAP_H
+
+/**
+ * @file TangoMap.h
+ *
+ * @author Zawarudo (@zawarudo)
+ *
+ * @brief A header file for a Tango Tree that maps its keys to values and answers range aggregate queries. The values are
+ * combined with a user supplied monoid (sum, min, max, ...), and every node keeps the aggregate of its subtree, updated
+ * bottom-up by update() like the depth fields. The aggregate of any key range is then read from O(log(n)) subtree
+ * aggregates.
+ *
+ * @version 1.0
+ * @date 2026-10-18
+ */
+
+// includes.
+#include "TangoTree.h"
+#include <utility>
+#include <vector>
+
+extern const Monoid SumMonoid;     // Sum of the values, identity 0.
+extern const Monoid MinMonoid;     // Min of the values, identity LLONG_MAX.
+extern const Monoid MaxMonoid;     // Max of the values, identity LLONG_MIN.
+
+/**
+ * @brief A class representing a Tango Tree map from int keys to long long values, with range aggregates over a monoid.
+ * The searches adapt the tree like the ones of TangoTree. The map can not be frozen, since the static layout has no
+ * room for the values.
+ */
+class TangoMap : private TangoTree {
+public:
+  /**
+   * @brief Construct a new empty Tango Map object.
+   *
+   * @param monoid The value monoid. It must outlive the map.
+   */
+  TangoMap(const Monoid &monoid);
+
+  /**
+   * @brief Construct a new Tango Map object over the given entries.
+   *
+   * @param entries The (key, value) entries, sorted by key and without duplicate keys.
+   * @param monoid The value monoid. It must outlive the map.
+   */
+  TangoMap(const std::vector<std::pair<int, long long>> &entries, const Monoid &monoid);
+
+  /**
+   * @brief Maps the given key to the given value, inserting the key if it is not in the map.
+   *
+   * @param key The key.
+   * @param value The value.
+   * @return true if the key was inserted, false if its value was replaced.
+   * @note Time Complexity: the cost of TangoTree::insert plus an access.
+   */
+  bool put(int key, long long value);
+
+  /**
+   * @brief Looks up the value mapped to the given key.
+   *
+   * @param key The key.
+   * @param value Set to the key value if the key is in the map.
+   * @return true if the key is in the map, false otherwise.
+   */
+  bool get(int key, long long &value);
+
+  /**
+   * @brief Returns the aggregate of the values with keys in [lo, hi], combined in key order. Both bounds are accessed
+   * first, so that the paths read by the query are in the upper preferred paths when a range is queried repeatedly.
+   *
+   * @param lo The lower bound of the key range.
+   * @param hi The upper bound of the key range.
+   * @return The range aggregate, or the monoid identity for an empty range.
+   * @note Time Complexity: the cost of two accesses, plus O(log(n)) subtree aggregates.
+   */
+  long long aggregate(int lo, int hi);
+
+  using TangoTree::contains;
+  using TangoTree::erase;
+  using TangoTree::rank;
+  using TangoTree::select;
+  using TangoTree::show;
+  using TangoTree::size;
+};
+
+#endif     // TANGOMAP_H
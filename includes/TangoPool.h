@@ -0,0 +1,143 @@
+#ifndef TANGOPOOL_H
+#define TANGOPOOL_H
+
+/**
+ * @file TangoPool.h
+ *
+ * @author Zawarudo (@zawarudo)
+ *
+ * @brief A header file for a pool of many small Tango Trees over static key sets. A TangoTree object carries its
+ * cache, fingers, filter and layout state and allocates every node on its own, which dominates the memory of a tree
+ * with a few dozen keys. The pool keeps a 24-byte header per tree and places the nodes of each tree in one block taken
+ * from size-classed arenas: the block of n nodes holds at most n/8 slack nodes, and trees are created and destroyed
+ * without touching the general purpose allocator, in bulk if needed.
+ *
+ * Accesses never allocate or free nodes, so a tree keeps its block for its whole life.
+ *
+ * @version 1.0
+ * @date 2026-10-18
+ */
+
+// includes.
+#include "TangoTree.h"
+#include <vector>
+
+/**
+ * @brief A class representing a pool of Tango Trees, each identified by a small integer id.
+ */
+class TangoPool {
+private:
+  /**
+   * @brief The header of a tree in the pool.
+   */
+  struct Tree {
+    Node *root;    // The tree root, or nil for an empty tree.
+    Node *block;   // The block holding the tree nodes, or nullptr for an empty tree or a free id.
+    int size;      // The number of keys in the tree, -1 for a free id.
+  };
+
+  /**
+   * @brief An arena of blocks of one size class.
+   */
+  struct SizeClass {
+    std::vector<Node *> free;   // The released blocks.
+    Node *next = nullptr;       // The next unused block of the current slab.
+    int left = 0;               // The number of unused blocks in the current slab.
+  };
+
+  std::vector<Tree> trees;          // The tree headers, indexed by id.
+  std::vector<int> freeIds;         // The ids of the destroyed trees, reused by create.
+  std::vector<SizeClass> classes;   // The arenas, indexed by size class.
+  std::vector<void *> slabs;        // The memory of all the arenas.
+  int live;                         // The number of trees in the pool.
+  size_t slabBytes;                 // The minimum size of the memory chunk carved into the blocks of a size class.
+
+  /**
+   * @brief Takes a block for n nodes from the arena of its size class.
+   *
+   * @param n The number of nodes, at least 1.
+   * @return The block.
+   */
+  Node *allocate(int n);
+
+public:
+  /**
+   * @brief Construct a new empty Tango Pool object, with the arena slab size of the default Tango Tree configuration.
+   */
+  TangoPool();
+
+  /**
+   * @brief Destroy the Tango Pool object, releasing all its trees.
+   */
+  ~TangoPool() { clear(); }
+
+  TangoPool(const TangoPool &) = delete;               // A pool owns its arenas, it can not be copied.
+  TangoPool &operator=(const TangoPool &) = delete;
+
+  /**
+   * @brief Creates a tree over the given keys.
+   *
+   * @param keys The keys, sorted in increasing order and without duplicates.
+   * @param n The number of keys.
+   * @return The tree id.
+   * @note Time Complexity: O(n).
+   */
+  int create(const int *keys, int n);
+
+  /**
+   * @brief Creates one tree per given key set.
+   *
+   * @param keySets The key sets, each sorted in increasing order and without duplicates.
+   * @return The tree ids, in the key set order.
+   */
+  std::vector<int> createBulk(const std::vector<std::vector<int>> &keySets);
+
+  /**
+   * @brief Destroys the given tree, returning its block to its arena. Destroying a free id does nothing, so that the id
+   * is not handed out twice.
+   *
+   * @param id The tree id.
+   * @note Time Complexity: O(1).
+   */
+  void destroy(int id);
+
+  /**
+   * @brief Destroys the given trees.
+   *
+   * @param ids The tree ids.
+   */
+  void destroyBulk(const std::vector<int> &ids);
+
+  /**
+   * @brief Destroys every tree and releases the arenas.
+   *
+   * @note Time Complexity: O(number of slabs).
+   */
+  void clear();
+
+  /**
+   * @brief Checks if the given tree contains the given key, with the Tango search.
+   *
+   * @param id The tree id.
+   * @param key The key to search for.
+   * @return true if the key is in the tree, false otherwise.
+   */
+  bool contains(int id, int key);
+
+  /**
+   * @brief Returns the number of keys in the given tree.
+   *
+   * @param id The tree id.
+   * @return The tree size.
+   */
+  int size(int id) const { return trees[id].size; }
+
+  /**
+   * @brief Returns the number of trees in the pool.
+   *
+   * @return The number of trees.
+   */
+  int count() const { return live; }
+};
+
+#endif     // TANGOPOOL_H
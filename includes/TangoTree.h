@@ -23,7 +23,48 @@
  */
 
 // includes. //
+#include "BloomFilter.h"
 #include "RedBlackTree.h"
+#include <vector>
+
+/**
+ * @brief A handle to a position in the Tango Tree, used to resolve accesses close to a previous one without starting the
+ * search at the root. A finger remembers a key found by an earlier access together with its two neighbours in the
+ * reference tree: the nearest ancestors with a smaller (prev) and a greater (next) key. Those are the keys placed right
+ * before and after the finger's reference subtree, so for a sequential scan the next key is often one of them. The
+ * finger also keeps the top, in the tree, of the reference subtree of its ancestor a few levels up, from which the keys
+ * of that subtree are searched while no access restructured the tree.
+ *
+ * @note When a neighbour does not exist (the finger is on the left or right spine of the reference tree), the field
+ * holds the finger key itself.
+ */
+struct Finger {
+  int key = 0;              // The key of the last access resolved through this finger.
+  int prev = 0;             // The nearest reference ancestor with a key smaller than key.
+  int next = 0;             // The nearest reference ancestor with a key greater than key.
+  bool isSet = false;       // Flag to indicate if the finger points to a key (a default finger points nowhere).
+  unsigned removals = 0;    // The number of keys the tree had removed when the finger was set, see accessNear.
+  Node *node = nullptr;     // The top of the searched subtree in the tree, nullptr when it can not be searched from.
+  long long low = 0;        // The greatest key below the searched subtree, exclusive bound of its keys.
+  long long high = 0;       // The smallest key above the searched subtree, exclusive bound of its keys.
+  unsigned version = 0;     // The tree version when the finger was set, the node is only followed in the same one.
+};
+
+/**
+ * @brief The tuning knobs of a Tango Tree, see TangoTree::configure. The default values are the ones of a tree that was
+ * never configured. The constructors, except fork which copies the source tree settings, apply a process-wide default
+ * configuration, read from the file named by the TANGOTREE_CONFIG environment variable if it is set, so that each host
+ * runs with the knobs calibrated for it (see calibrate in TangoTune.h). The pools read their slab size from it too.
+ */
+struct TangoConfig {
+  int cacheSets = 0;           // The number of result cache sets, see setCacheSize.
+  int filterBits = 0;          // The number of Bloom filter bits per key, see setFilter.
+  int fingers = 0;             // The number of fingers, see setFingerCount.
+  unsigned coldAge = 0;        // The cold mode age, see setColdAge.
+  bool biased = false;         // Flag to choose the biased auxiliary trees, see setBiased.
+  size_t parallelCutoff = 0;   // The minimum number of keys of a parallel construction, 0 for the built-in one. It is a process-wide knob, see setParallelCutoff.
+  size_t slabBytes = 0;        // The size of the arena slabs of the pools created from now on, 0 for the built-in one, see TangoPool.
+};
 
 /**
  * @brief A class representing a Tango Tree data structure. A Tango Tree is a self-adjusting binary search tree that
@@ -32,8 +73,175 @@
  * required.
  */
 class TangoTree {
+protected:
+  Node *root;              // The Tango Tree's root node.
+  int count;               // The number of nodes in the tree, tombstones included.
+  int deleted;             // The number of tombstones (erased keys whose nodes are still in the tree).
+  int low;                 // A lower bound of the keys in the tree.
+  int high;                // An upper bound of the keys in the tree.
+  const Monoid *monoid;    // The value monoid when the nodes are map nodes, nullptr otherwise.
+
+  /**
+   * @brief Construct a new Tango Tree object from the given nodes, linked in the balanced configuration without any
+   * allocation. The tree takes ownership of the nodes.
+   *
+   * @param nodes The nodes, sorted by key, without duplicates.
+   * @param monoid The value monoid if the nodes are map nodes, nullptr otherwise.
+   */
+  TangoTree(std::vector<Node *> nodes, const Monoid *monoid);
+
+  /**
+   * @brief Performs the Tango search for the given key, applying tango operations until the key is found in the root
+   * preferred path or the search fails.
+   *
+   * @param key The key to search for.
+   * @return The node with the given key, or the nil node if the key is not in the tree.
+   */
+  Node *access(int key);
+
+  /**
+   * @brief Creates a node for a new key, a map node with the identity value when the tree has a monoid.
+   *
+   * @param key The key.
+   * @param depth The node depth in the reference tree.
+   * @return The new node.
+   */
+  Node *newKeyNode(int key, int depth);
+
+  /**
+   * @brief Recomputes the subtree fields along the path of the given key after a change to its node. The key must be in
+   * the root preferred path, as it is right after its access.
+   *
+   * @param key The key.
+   */
+  void refresh(int key);
+
 private:
-  Node *root; // The Tango Tree's root node.
+  /**
+   * @brief An entry of the result cache kept in front of contains. It stores a recently searched key and the search
+   * result.
+   */
+  struct CacheLine {
+    int key = 0;           // The cached key.
+    bool found = false;    // The search result for the key.
+    bool valid = false;    // Flag to indicate if the entry holds a key.
+  };
+
+  int filterBits;       // The number of Bloom filter bits per key (0 when the filter is off).
+  BloomFilter filter;   // The negative lookup filter, holding every key inserted since it was built.
+
+  std::vector<CacheLine> cache;   // The 2-way set associative result cache, the two ways of set i in 2i and 2i + 1.
+
+  bool isFrozen;             // Flag to indicate if the tree is frozen into the static layout.
+  std::vector<int> layout;   // The frozen keys in Eytzinger (BFS) order, 1-indexed (layout[0] is unused).
+
+  int maxFingers;                // The number of fingers kept by contains (0 when the finger mode is off).
+  std::vector<Finger> fingers;   // The fingers kept by contains, the most recently used first.
+
+  std::vector<int> pinned;   // The pinned keys, sorted, answered by contains before the cache.
+
+  unsigned epoch;     // The number of accesses so far, stamped on the external subtrees they leave behind.
+  unsigned removals;  // The number of keys removed so far, stamped on the fingers so that stale ones are ignored.
+  unsigned version;   // The number of restructurings so far, stamped on the fingers so that their node is not followed
+                      // once the tree changed shape.
+  unsigned coldAge;   // The age, in accesses, at which external subtrees are compressed (0 when the cold mode is off).
+
+  const AuxiliaryTree *aux;   // The auxiliary tree operations, red-black or biased.
+
+  /**
+   * @brief Builds a finger for a node just reached by access. The node and all its reference ancestors are in the root
+   * preferred path at this point, so its neighbours, and the searched subtree, are read from the root auxiliary tree.
+   *
+   * @param x The node found by the last access.
+   * @return The finger pointing to x.
+   */
+  Finger fingerOf(Node *x);
+
+  /**
+   * @brief Rebuilds the tree into the balanced configuration the constructor produces, reusing the nodes, linked in
+   * parallel for large trees. Tombstones are dropped and cold stubs expanded in the process.
+   */
+  void rebuild();
+
+  /**
+   * @brief Links the given nodes into the balanced configuration as the whole tree, dropping the tombstones, and resets
+   * the counters, the key range and the filter accordingly.
+   *
+   * @param nodes The nodes, sorted by key, none of them shared with a fork.
+   */
+  void relink(std::vector<Node *> &nodes);
+
+  /**
+   * @brief Rebuilds the reference subtree of the root preferred path node with the given depth into the balanced
+   * configuration, dropping its tombstones. The rest of the tree, and the depths of the rebuilt nodes' ancestors, do
+   * not change.
+   *
+   * @param key A key of the subtree, in the root preferred path.
+   * @param depth The depth of the subtree root, at least 1.
+   */
+  void rebuildSubtree(int key, int depth);
+
+  /**
+   * @brief Restores the depth bound after a new key was added deeper than it: the key is accessed and the deepest
+   * reference ancestor whose subtree is more than twice as high as a balanced tree of its size is rebuilt, the whole
+   * tree if it is the root.
+   *
+   * @param key The new key.
+   * @param depth The depth of the new key.
+   */
+  void rebalance(int key, int depth);
+
+  /**
+   * @brief Builds the negative lookup filter over the keys currently in the tree, sized for twice their number.
+   */
+  void buildFilter();
+
+  /**
+   * @brief Branchless search of the given key in the frozen layout.
+   *
+   * @param key The key to search for.
+   * @return true if the key is in the layout, false otherwise.
+   */
+  bool frozenContains(int key) const;
+
+  /**
+   * @brief Returns the rank of the given key in the frozen layout.
+   *
+   * @param key The key.
+   * @return The number of frozen keys smaller than the key.
+   */
+  int frozenRank(int key) const;
+
+  /**
+   * @brief Returns the frozen key with the given rank.
+   *
+   * @param i The rank, from 0 to size() - 1.
+   * @return The i-th smallest frozen key.
+   */
+  int frozenSelect(int i) const;
+
+  /**
+   * @brief Returns the cache line holding the given key, if any.
+   *
+   * @param key The key to look for.
+   * @return A pointer to the cache line with the key, or nullptr if the key is not cached.
+   */
+  CacheLine *cacheFind(int key);
+
+  /**
+   * @brief Stores the search result of a key in the cache, evicting the least recently used way of its set.
+   *
+   * @param key The searched key.
+   * @param found The search result.
+   */
+  void cachePut(int key, bool found);
+
+  /**
+   * @brief Construct a new Tango Tree object sharing all the nodes of the given one, see fork.
+   *
+   * @param source The tree to fork.
+   */
+  explicit TangoTree(const TangoTree *source);
 
 public:
   /**
@@ -43,6 +251,64 @@ public:
    */
   TangoTree(int n);
 
+  /**
+   * @brief Construct a new Tango Tree object over an arbitrary key set. The reference tree is the balanced tree over the
+   * given keys, built in parallel for large key sets.
+   *
+   * @param keys The tree keys, sorted in increasing order and without duplicates.
+   */
+  TangoTree(const std::vector<int> &keys);
+
+  /**
+   * @brief Construct a new Tango Tree object over the given array of keys, such as a memory mapped key file. See the
+   * vector constructor.
+   *
+   * @param keys The tree keys, sorted in increasing order and without duplicates.
+   * @param n The number of keys.
+   */
+  TangoTree(const int *keys, int n);
+
+  /**
+   * @brief Destroy the Tango Tree object, releasing all its nodes.
+   */
+  ~TangoTree();
+
+  TangoTree(const TangoTree &) = delete;               // A tree owns its nodes, it can not be copied.
+  TangoTree &operator=(const TangoTree &) = delete;
+
+  /**
+   * @brief Converts the given red-black tree into a Tango Tree over the same keys, in the balanced configuration of the
+   * constructors. The nodes are reused: the red-black tree is consumed and the Tango Tree takes ownership of them.
+   *
+   * @param rbt The red-black tree root.
+   * @return The Tango Tree.
+   * @note Time Complexity: O(n).
+   */
+  static TangoTree fromRedBlackTree(Node *rbt);
+
+  /**
+   * @brief Converts the tree into a balanced red-black tree over the same keys, reusing the nodes (tombstones are
+   * released). The caller takes ownership of the red-black tree and the Tango Tree is left empty. A frozen tree is
+   * thawed first, which allocates its nodes.
+   *
+   * @return The red-black tree root.
+   * @note Time Complexity: O(n).
+   */
+  Node *toRedBlackTree();
+
+  /**
+   * @brief Returns a logically independent copy of the tree that shares all the nodes with it, copy on write. The
+   * sharing is tracked per auxiliary tree: the first restructuring of a shared auxiliary tree, by either tree, copies
+   * its O(log(n)) nodes and shares the external subtrees below them. The memory of a fork is then proportional to the
+   * part of the tree its accesses touch. A rebuild or a conversion to a red-black tree copies the whole tree.
+   *
+   * @return The fork. It starts with the finger state of the tree, and without the result cache and the filter, which
+   * can be set again.
+   * @note A tree and its forks share nodes, so they must be used from the same thread.
+   * @note Time Complexity: O(1), O(n) for a frozen tree, whose layout is copied.
+   */
+  TangoTree fork();
+
   /**
    * @brief Checks if the Tango Tree contains the given key. This operation performs a search for the specified key in
    * the Tango Tree. The search can modify the current tree struct using the Tango operation. See search in Tango
@@ -53,6 +319,289 @@ public:
    */
   bool contains(int key);
 
+  /**
+   * @brief Checks a batch of keys at once. The keys are searched in increasing order rather than in the given one:
+   * consecutive keys then share most of their reference path, which stays in the root preferred path between the
+   * searches, and repeated keys are searched once.
+   *
+   * @param keys The keys to search for.
+   * @param n The number of keys.
+   * @param found Set, for each key, to true if the key is in the tree and to false otherwise.
+   * @note Time Complexity: O(n log(n)) to sort the keys, plus the cost of contains for each distinct key.
+   */
+  void containsBatch(const int *keys, int n, bool *found);
+
+  /**
+   * @brief Announces keys about to be searched, so that the restructuring runs ahead of the lookups, between requests.
+   * The keys are accessed in reverse order, which leaves the reference path of the first one in the root preferred path
+   * and the paths of the following ones in the auxiliary trees right below it, and their results are stored in the
+   * result cache when it is on. Keys rejected by the key range or the filter are skipped.
+   *
+   * @param keys The upcoming keys, in their expected lookup order.
+   * @param n The number of keys.
+   * @note The hint is advisory: the answers of later calls do not depend on it.
+   * @note Time Complexity: the cost of contains for each key.
+   */
+  void hint(const int *keys, int n);
+
+  /**
+   * @brief Discards the adaptation to past accesses: the nodes are relinked, in place, into the balanced configuration
+   * of the constructors, where every node is a preferred path by itself. This is useful when the hot set shifts
+   * abruptly and the current preferred paths no longer match the accesses. Tombstones are released on the way.
+   *
+   * @note Cold stubs are expanded, a later sweep compresses them again.
+   * @note Time Complexity: O(n), with the nodes linked in parallel for large trees.
+   */
+  void resetAdaptation();
+
+  /**
+   * @brief Chooses the auxiliary trees holding the preferred paths. The red-black trees (the default) reach every key of
+   * a path in O(log(log(n))) steps. The biased trees are treaps prioritized by the decayed access counts of the keys,
+   * halved every n accesses, so the keys that receive most of the hits on a path sit near its root, while a path of
+   * equally hot keys stays balanced in expectation.
+   *
+   * @param enabled true for the biased auxiliary trees, false for the red-black ones.
+   * @note Time Complexity: O(n) when the kind changes, since the tree is relinked into single node paths.
+   */
+  void setBiased(bool enabled);
+
+  /**
+   * @brief Applies the per-tree knobs of the given configuration, as the matching setters do. The parallel cutoff and
+   * the slab size are process-wide knobs and are left alone, see setDefaultConfig.
+   *
+   * @param config The configuration.
+   * @note Time Complexity: O(n) when the filter is on or the auxiliary tree kind changes.
+   */
+  void configure(const TangoConfig &config);
+
+  /**
+   * @brief Sets the configuration applied by the constructors from now on, and the process-wide parallel cutoff. It
+   * replaces the one read from the TANGOTREE_CONFIG file, and should be set before the trees are built.
+   *
+   * @param config The configuration.
+   */
+  static void setDefaultConfig(const TangoConfig &config);
+
+  /**
+   * @brief Returns the configuration applied by the constructors. On the first call, it is read from the file named by
+   * the TANGOTREE_CONFIG environment variable, if any, see loadConfig.
+   *
+   * @return The default configuration.
+   */
+  static TangoConfig defaultConfig();
+
+  /**
+   * @brief Returns the number of keys smaller than the given key, which does not need to be in the tree. The key is
+   * accessed first, as in contains, so that the search path is in the root preferred path and the count is read from
+   * the subtree sizes along it.
+   *
+   * @param key The key.
+   * @return The rank of the key.
+   * @note Time Complexity: the cost of an access, plus O(log(log(n))) to read the count.
+   */
+  int rank(int key);
+
+  /**
+   * @brief Returns the key with the given rank, the i-th smallest key counting from 0. The key is found following the
+   * subtree sizes and then accessed, so that repeated queries around the same rank adapt the tree like contains does.
+   *
+   * @param i The rank.
+   * @return The key with rank i.
+   * @note Precondition: i must be in [0, size()).
+   * @note Time Complexity: O(log(n) log(log(n))) to find the key, plus the cost of its access.
+   */
+  int select(int i);
+
+  /**
+   * @brief Returns the number of keys in the tree.
+   *
+   * @return The tree size.
+   */
+  int size() const { return count - deleted; }
+
+  /**
+   * @brief Turns the finger mode on or off. In finger mode, contains first checks the key against the finger left by the
+   * previous access and answers without touching the tree when the key is the finger key or one of its neighbours.
+   * A key in the reference subtree of the finger's ancestor a few levels up is searched from that subtree instead of
+   * the root, in a bounded number of steps and without restructuring, as long as no access changed the tree since the
+   * finger was set. This favours near-sequential access patterns, where about half of the keys of a monotone scan are
+   * neighbours of the previous one and most of the others are in the same small subtree.
+   *
+   * @param enabled true to turn the finger mode on, false to turn it off.
+   */
+  void setFingerMode(bool enabled);
+
+  /**
+   * @brief Sets the number of fingers kept by contains, so that interleaved sequential streams keep one finger each.
+   * A key is resolved from a finger that knows it, if any. On a miss, the finger whose neighbourhood contains the key
+   * (the stream the key belongs to) follows the access, otherwise the least recently used finger is replaced.
+   *
+   * @param k The number of fingers, 0 turns the finger mode off and 1 is the same as setFingerMode(true).
+   * @note A key resolved by a finger is answered without restructuring, even if the finger was left by another stream
+   * and its keys are no longer in the root preferred path.
+   * @note Time Complexity: O(k) extra per contains call.
+   */
+  void setFingerCount(int k);
+
+  /**
+   * @brief Pins a key of the tree, for the few keys (sentinels, control ids) hit by nearly every request. contains
+   * answers a pinned key from a small sorted array checked before the cache, with no search and no tango operation, so
+   * the key never pays for the accesses in between and never pulls the root preferred path away from the other keys.
+   * Erasing the key unpins it.
+   *
+   * @param key The key to pin.
+   * @return true if the key is in the tree and is now pinned, false if it is not in the tree.
+   * @note Time Complexity: the cost of contains, plus O(k) for k pinned keys. A pinned key is then found in O(log(k)).
+   */
+  bool pin(int key);
+
+  /**
+   * @brief Unpins a key, which is answered by the tree again.
+   *
+   * @param key The key to unpin.
+   * @return true if the key was pinned, false otherwise.
+   * @note Time Complexity: O(k) for k pinned keys.
+   */
+  bool unpin(int key);
+
+  /**
+   * @brief Sets the size of the result cache placed in front of contains. The cache is 2-way set associative and keeps
+   * the most recent results (hits and misses) of contains. A key found in the cache is answered without searching or
+   * restructuring the tree. Insert and erase keep the cache consistent.
+   *
+   * @param sets The number of sets, rounded up to a power of two. 0 turns the cache off.
+   */
+  void setCacheSize(int sets);
+
+  /**
+   * @brief Sets the negative lookup filter consulted by contains before the tree. Keys outside the range of the keys in
+   * the tree are always rejected right away; with the filter on, a blocked Bloom filter over the keys also rejects most
+   * absent keys inside that range. A rejected key is answered with one cache line read and no restructuring.
+   *
+   * @param bitsPerKey The number of filter bits per key (8 to 16 is a good range). 0 turns the filter off.
+   * @note Time Complexity: O(n) to build the filter.
+   */
+  void setFilter(int bitsPerKey);
+
+  /**
+   * @brief Turns the cold mode on or off. In cold mode, every given number of accesses the external subtrees that no
+   * search entered for at least that many accesses are compressed into cold stubs, which keep the reference shape and
+   * the keys as varint gaps, a few bytes per key instead of a full node. A search entering a stub expands its root only,
+   * leaving the two subtrees as smaller stubs, so it decodes one node per level it goes down. The subtrees of the
+   * expanded nodes it does not follow are compressed again by a later sweep.
+   *
+   * @param accesses The sweep period and minimum age, in accesses. 0 turns the cold mode off.
+   * @note Time Complexity: a sweep is O(number of uncompressed nodes), amortized over the period.
+   */
+  void setColdAge(unsigned accesses);
+
+  /**
+   * @brief Compresses now the external subtrees that no search entered for at least the given number of accesses, as the
+   * cold mode sweep does. The root preferred path is never compressed.
+   *
+   * @param age The minimum age, in accesses. 0 compresses every external subtree.
+   * @return The number of nodes compressed.
+   * @note Trees with values (TangoMap) are not compressed.
+   * @note Time Complexity: O(n).
+   */
+  int compress(unsigned age);
+
+  /**
+   * @brief Inserts the given key in the Tango Tree. The key is searched first, which brings the whole reference path to
+   * its position to the root preferred path, and is then added as a new leaf of the reference tree hanging from that
+   * path. When the new leaf is deeper than twice the balanced height, the reference subtree of its deepest ancestor
+   * that is too deep for its size is rebuilt, as in a scapegoat tree.
+   *
+   * @param key The key to insert.
+   * @return true if the key was inserted, false if it was already in the tree.
+   * @note Time Complexity: the cost of contains, plus O(log(n)) amortized for the rebuilds.
+   */
+  bool insert(int key);
+
+  /**
+   * @brief Inserts a sorted batch of keys. Each run of keys falling between two consecutive keys of the tree is added
+   * with one access, as a balanced reference subtree hanging where its first key would be inserted, and only the
+   * reference subtrees that become too deep are rebuilt (see pushBack). A batch at least as large as the tree is merged
+   * with its nodes, which are relinked in the balanced configuration.
+   *
+   * @param keys The keys, sorted in increasing order. Keys already in the tree are skipped.
+   * @param n The number of keys.
+   * @return The number of keys inserted.
+   * @note Time Complexity: O(n) plus the cost of an access per run, O(n + size()) for a large batch.
+   */
+  int insertBatch(const int *keys, int n);
+
+  /**
+   * @brief Erases the given key from the Tango Tree. Its node is kept in the reference tree as a tombstone, so the
+   * reference depths of the other keys do not change. When more than half of the nodes are tombstones, the tree is
+   * rebuilt without them.
+   *
+   * @param key The key to erase.
+   * @return true if the key was erased, false if it was not in the tree.
+   * @note Time Complexity: the cost of contains, plus O(n) on a rebuild.
+   */
+  bool erase(int key);
+
+  /**
+   * @brief Appends a key greater than every key in the tree, the insert of a sliding window. The new key becomes the
+   * right reference child of the max node, which is reached following the right pointers with no search and no tango
+   * operation. When the new leaf is too deep, only the smallest right spine subtree that is too deep for its size is
+   * rebuilt, as in a scapegoat tree, instead of the whole tree.
+   *
+   * @param key The key to append. A key not greater than every key (tombstones included) is inserted with insert.
+   * @return true if the key was inserted, false if it was already in the tree.
+   * @note Time Complexity: O(log(n) log(log(n))) to reach the max node, plus O(log(n)) amortized for the rebuilds.
+   */
+  bool pushBack(int key);
+
+  /**
+   * @brief Erases the smallest key, the delete of a sliding window. The key is found following the subtree sizes and
+   * left as a tombstone, as erase does, with no search and no tango operation.
+   *
+   * @return The erased key.
+   * @note Precondition: the tree must not be empty.
+   * @note Time Complexity: O(log(n) log(log(n))), plus O(n) on a rebuild, amortized O(1) over the erased keys.
+   */
+  int popFront();
+
+  /**
+   * @brief Freezes the tree for a read-only phase. The keys are flattened into a sorted array stored in Eytzinger (BFS)
+   * order, searched by contains with a branchless, prefetching loop, and the nodes are released. Insert and erase thaw
+   * the tree before changing it.
+   *
+   * @note Time Complexity: O(n), with the layout filled in parallel for large trees.
+   */
+  void freeze();
+
+  /**
+   * @brief Restores an adaptive tree from the frozen layout. The new tree starts in the balanced configuration, as if
+   * it was just constructed over the frozen keys.
+   *
+   * @note Time Complexity: O(n), with the keys read back and the nodes built in parallel for large trees.
+   */
+  void thaw();
+
+  /**
+   * @brief Checks if the tree is frozen.
+   *
+   * @return true if the tree is frozen, false if it is adaptive.
+   */
+  bool frozen() const { return isFrozen; }
+
+  /**
+   * @brief Checks if the Tango Tree contains the given key, starting from the given finger. If the key is the finger key
+   * or one of its neighbours the answer is immediate and the tree is not restructured. A key near the finger is
+   * searched from its subtree, as contains does in finger mode. Otherwise a regular search is performed and, on
+   * success, the finger is moved to the found key. A finger set before a key was erased from the tree may know that
+   * key, so it is not trusted and the key is searched.
+   *
+   * @param handle The finger to start from. It is updated to point to the key if the key is found by a search.
+   * @param key The key to search for in the Tango Tree.
+   * @return true if the key is found in the Tango Tree, false otherwise.
+   * @note Time Complexity: O(1) when resolved by the finger or its subtree, the cost of contains otherwise.
+   */
+  bool accessNear(Finger &handle, int key);
+
   /**
    * @brief Prints the Tango Tree in a human-readable format. This method is useful for debugging and visualization
    * purposes, allowing users to see the structure of the Tango Tree and understand how the nodes are arranged.
@@ -60,4 +609,53 @@ public:
   void show();
 };
 
-#endif TANGOTREE_H
\ No newline at end of file
+// Tango Tree functions. //
+
+/**
+ * @brief Performs the Tango search for the given key in the tree with the given root, applying tango operations until
+ * the key is found in the root preferred path or the search fails. This is the search loop of TangoTree, for containers
+ * that manage the nodes themselves.
+ *
+ * @param root The tree root. It is updated to the new root.
+ * @param key The key to search for.
+ * @param stamp The access count stamped on the external subtrees the search leaves behind.
+ * @param aux The auxiliary tree operations.
+ * @return The node with the given key, or the nil node if the key is not in the tree.
+ * @note Time Complexity: O(log(log(n))) competitive, amortized.
+ */
+Node *accessTango(Node *&root, int key, unsigned stamp = 0, const AuxiliaryTree &aux = RedBlackAuxiliary);
+
+/**
+ * @brief Reads a configuration file. The file holds one "name = value" line per knob, with the names of the TangoConfig
+ * fields, and "#" starts a comment. The knobs missing from the file keep the given values and unknown names are
+ * ignored, so that files written for other versions still load.
+ *
+ * @param path The file path.
+ * @param config The configuration to update. It is left unchanged if the file can not be read or a line is invalid.
+ * @return true if the file was read, false otherwise.
+ */
+bool loadConfig(const char *path, TangoConfig &config);
+
+/**
+ * @brief Writes a configuration file that loadConfig reads back.
+ *
+ * @param path The file path.
+ * @param config The configuration.
+ * @return true if the file was written, false otherwise.
+ */
+bool saveConfig(const char *path, const TangoConfig &config);
+
+/**
+ * @brief Builds a Tango Tree over the given sorted keys in caller provided storage, in the balanced configuration of
+ * the TangoTree constructors. The nodes are constructed in place, one per key, and are never reallocated by accesses:
+ * the storage can be released in one piece once the tree is no longer used.
+ *
+ * @param storage The storage for n nodes.
+ * @param keys The keys, sorted in increasing order and without duplicates.
+ * @param n The number of keys.
+ * @return The tree root.
+ * @note Time Complexity: O(n).
+ */
+Node *buildTangoInPlace(Node *storage, const int *keys, int n);
+
+#endif     // TANGOTREE_H
\ No newline at end of file
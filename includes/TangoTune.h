@@ -0,0 +1,40 @@
+#ifndef TANGOTUNE_H
+#define TANGOTUNE_H
+
+/**
+ * @file TangoTune.h
+ *
+ * @author Zawarudo (@zawarudo)
+ *
+ * @brief A header file for the Tango Tree calibration routine. The knobs whose best value depends on the host, the size
+ * of the result cache against the cache hierarchy, the Bloom filter against the cost of a tree miss, the pool slab size
+ * against the allocator and the parallel cutoff against the cost of starting a thread, are chosen by running short
+ * microbenchmarks. The result is meant to be saved with saveConfig and read back by the trees of every later run
+ * through the TANGOTREE_CONFIG file (see TangoConfig in TangoTree.h), or applied right away with
+ * TangoTree::setDefaultConfig.
+ *
+ * @version 1.0
+ * @date 2026-10-18
+ */
+
+// includes.
+#include "TangoTree.h"
+
+/**
+ * @brief Chooses the host dependent knobs with microbenchmarks, in a few seconds for the default size. The cache and
+ * filter are timed on a tree of n keys under a mixed query stream: skewed hits on a hot set, uniform hits and absent
+ * keys inside the key range. The slab size is timed on a pool creating, searching and destroying small trees of about
+ * n keys in all. The parallel cutoff is the smallest construction size, doubling from 4096, that a parallel
+ * build speeds up, and is kept as is on a single core host. A larger setting is only chosen when it is clearly faster,
+ * so that a flat result keeps the smaller, cheaper setting.
+ *
+ * @param n The number of keys of the benchmark trees.
+ * @param base The configuration to start from. The knobs that depend on the workload (fingers, cold age and auxiliary
+ * tree kind) are copied from it.
+ * @return The calibrated configuration.
+ * @note The default configuration and the process-wide parallel cutoff are changed while the benchmarks run and are
+ * restored before returning, so no other thread should build trees or pools meanwhile.
+ */
+TangoConfig calibrate(int n = 1 << 15, const TangoConfig &base = TangoConfig());
+
+#endif     // TANGOTUNE_H
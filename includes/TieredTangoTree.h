@@ -0,0 +1,74 @@
+#ifndef TIEREDTANGOTREE_H
+#define TIEREDTANGOTREE_H
+
+/**
+ * @file TieredTangoTree.h
+ *
+ * @author Zawarudo (@zawarudo)
+ *
+ * @brief A header file for a tiered key store built on top of the Tango Tree. Most keys of a large universe are almost
+ * never accessed, yet in a plain Tango Tree every key pays a full node and deepens the reference tree. The tiered store
+ * keeps every key in a frozen (static, Eytzinger ordered) cold tier of 4 bytes per key, and only the frequently accessed
+ * keys in a small adaptive hot Tango Tree, which stays shallow. Keys are promoted and demoted at the end of each epoch
+ * by their decayed access counts.
+ *
+ * @version 1.0
+ * @date 2026-10-18
+ */
+
+// includes.
+#include "TangoTree.h"
+#include <memory>
+#include <unordered_map>
+#include <vector>
+
+/**
+ * @brief A class representing a tiered key store: a frozen cold tier with all the keys and an adaptive hot tier with
+ * the most accessed ones.
+ */
+class TieredTangoTree {
+private:
+  TangoTree cold;                   // The cold tier, a frozen tree with every key.
+  std::unique_ptr<TangoTree> hot;   // The hot tier, an adaptive tree over the hot keys.
+
+  int hotCapacity;   // The maximum number of hot keys.
+  int epochLength;   // The number of accesses between two tier updates.
+  int accesses;      // The number of accesses in the current epoch.
+  int hotKeys;       // The number of keys in the hot tier.
+
+  std::unordered_map<int, unsigned> counts;   // The decayed access counts of the recently accessed keys.
+
+  /**
+   * @brief Rebuilds the hot tier with the keys of highest access count and halves all the counts, forgetting the keys
+   * whose count drops to zero.
+   */
+  void retier();
+
+public:
+  /**
+   * @brief Construct a new Tiered Tango Tree object over the given keys, all of them cold.
+   *
+   * @param keys The keys, sorted in increasing order and without duplicates.
+   * @param hotCapacity The maximum number of keys in the hot tier.
+   * @param epochLength The number of accesses between two tier updates.
+   */
+  TieredTangoTree(const std::vector<int> &keys, int hotCapacity, int epochLength = 1 << 16);
+
+  /**
+   * @brief Checks if the store contains the given key. The hot tier is searched first (with a Bloom filter in front of it,
+   * so cold keys rarely reach its nodes), then the cold tier. The access is counted for the next tier update.
+   *
+   * @param key The key to search for.
+   * @return true if the key is in the store, false otherwise.
+   */
+  bool contains(int key);
+
+  /**
+   * @brief Returns the number of keys in the hot tier.
+   *
+   * @return The hot tier size.
+   */
+  int hotSize() const { return hotKeys; }
+};
+
+#endif     // TIEREDTANGOTREE_H
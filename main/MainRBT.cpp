@@ -25,121 +25,313 @@
  * and right subtree are printed to the output, and the original tree with id <id> is cleared.
  *
  * print:       7 <id>                - Prints the tree with id <id>
+ *
+ * rank:        8 <id> <k>            - Prints the number of keys smaller than <k> in the tree with id <id>.
+ *
+ * select:      9 <id> <i>            - Prints the key with rank <i> (counting from 0) in the tree with id <id>.
+ *
+ * load:        10 <id> <file>        - Replaces the tree with id <id> by a tree built from the binary key file <file> (raw 32-bit integers, sorted and
+ * without duplicates). The file is memory mapped and the tree is built in linear time, in parallel for large files.
+ *
+ * By default the operations are applied one by one as they are read. With the option -j <threads>, the whole script is
+ * read first and replayed on a pool of worker threads (0 uses every hardware thread, at most 1024). Operations on different trees
+ * never interact, so the script is partitioned into groups of tree ids (the two ids of a join belong to the same group)
+ * and each group is replayed in order on one worker. The output is printed in the script order.
  */
 
 // includes.
+#include "KeyFile.h"
 #include "RedBlackTree.h"
+#include <algorithm>
+#include <atomic>
+#include <cerrno>
+#include <cstdlib>
+#include <cstring>
 #include <iostream>
 #include <map>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <vector>
 
-int main() {
-  std::map<int, Node *> trees;     // Map to store trees by ID.
+// defines.
+#define MAX_THREADS 1024     // Upper bound of the -j option.
 
-  int operation, id, val, id2, key;
+/**
+ * @brief Struct to represent an operation of the script: its code and its arguments.
+ */
+struct Operation {
+  int code;           // The operation code (0 to 10).
+  int args[3];        // The operation arguments, as many as the operation takes.
+  std::string path;   // The key file of a load operation.
+};
 
-  while (std::cin >> operation) {
-    switch (operation) {
-    case 0: {
-      int l, r;
-      std::cin >> id >> l >> r;
-      if (trees.count(id) == 0)
-        trees[id] = Node::nil;
+/**
+ * @brief Returns the number of arguments of the given operation, 0 for an invalid operation.
+ *
+ * @param code The operation code.
+ * @return The number of arguments.
+ */
+int arity(int code) {
+  static const int ARITY[] = {3, 2, 2, 1, 1, 3, 2, 1, 2, 2, 1};
+  return code >= 0 && code <= 10 ? ARITY[code] : 0;
+}
 
-      for (int i = l; i <= r; i++)
-        trees[id] = insert(trees[id], i);
+/**
+ * @brief Reads the next operation from the given stream.
+ *
+ * @param in The input stream.
+ * @param op The operation read.
+ * @return true if an operation was read, false at the end of the input.
+ */
+bool readOperation(std::istream &in, Operation &op) {
+  if (!(in >> op.code))
+    return false;
+  for (int i = 0; i < arity(op.code); i++)
+    in >> op.args[i];
+  if (op.code == 10)
+    in >> op.path;
+  return true;
+}
 
-      break;
-    }
-    case 1: {
-      // Insert.
-      std::cin >> id >> val;
-      if (trees.count(id) == 0)
-        trees[id] = Node::nil;
+/**
+ * @brief Applies the given operation on the given trees.
+ *
+ * @param op The operation.
+ * @param trees The trees by id.
+ * @param out The stream where the operation output is written.
+ */
+void apply(const Operation &op, std::map<int, Node *> &trees, std::ostream &out) {
+  int id = op.args[0];
 
-      trees[id] = insert(trees[id], val);
+  switch (op.code) {
+  case 0: {
+    // Build.
+    if (trees.count(id) == 0)
+      trees[id] = Node::nil;
 
-      std::cout << "Inserted " << val << " into tree " << id << std::endl;
+    for (int i = op.args[1]; i <= op.args[2]; i++)
+      trees[id] = insert(trees[id], i);
 
-      break;
-    }
-    case 2: {
-      // Contains.
-      std::cin >> id >> val;
-      Node *tree = (trees.count(id) > 0) ? trees[id] : Node::nil;
-      bool found = (search(tree, val).first != Node::nil);
-      std::cout << (found ? "True" : "False") << std::endl;
-      break;
-    }
-    case 3: {
-      // deleteMin.
-      std::cin >> id;
-      Node *tree = (trees.count(id) > 0) ? trees[id] : Node::nil;
-      if (tree == Node::nil) {
-        std::cout << "Tree with id: " << id << " is empty" << std::endl;
-      } else {
-        auto [_min, t] = deleteMin(tree);
-        trees[id] = t;
-      }
-      break;
+    break;
+  }
+  case 1: {
+    // Insert.
+    int val = op.args[1];
+    if (trees.count(id) == 0)
+      trees[id] = Node::nil;
+
+    trees[id] = insert(trees[id], val);
+
+    out << "Inserted " << val << " into tree " << id << std::endl;
+
+    break;
+  }
+  case 2: {
+    // Contains.
+    Node *tree = (trees.count(id) > 0) ? trees[id] : Node::nil;
+    bool found = (search(tree, op.args[1]).first != Node::nil);
+    out << (found ? "True" : "False") << std::endl;
+    break;
+  }
+  case 3: {
+    // deleteMin.
+    Node *tree = (trees.count(id) > 0) ? trees[id] : Node::nil;
+    if (tree == Node::nil) {
+      out << "Tree with id: " << id << " is empty" << std::endl;
+    } else {
+      auto [_min, t] = deleteMin(tree);
+      trees[id] = t;
     }
-    case 4: {
-      // deleteMax.
-      std::cin >> id;
-      Node *tree = (trees.count(id) > 0) ? trees[id] : Node::nil;
-      if (tree == Node::nil) {
-        std::cout << "Tree with id: " << id << " is empty" << std::endl;
-      } else {
-        auto [_max, t] = deleteMax(tree);
-        trees[id] = t;
-      }
-      break;
+    break;
+  }
+  case 4: {
+    // deleteMax.
+    Node *tree = (trees.count(id) > 0) ? trees[id] : Node::nil;
+    if (tree == Node::nil) {
+      out << "Tree with id: " << id << " is empty" << std::endl;
+    } else {
+      auto [_max, t] = deleteMax(tree);
+      trees[id] = t;
     }
-    case 5: {
-      // Join.
-      int id1;
-      std::cin >> id1 >> key >> id2;
-      Node *t1 = (trees.count(id1) > 0) ? trees[id1] : Node::nil;
-      Node *t2 = (trees.count(id2) > 0) ? trees[id2] : Node::nil;
-      Node *separator = newNode(key);
-      Node *result = join(t1, separator, t2);
-      trees[id1] = result;        // Store result in first tree's ID.
-      trees[id2] = Node::nil;     // Clear second tree's ID.
-      break;
+    break;
+  }
+  case 5: {
+    // Join.
+    int id2 = op.args[2];
+    Node *t1 = (trees.count(id) > 0) ? trees[id] : Node::nil;
+    Node *t2 = (trees.count(id2) > 0) ? trees[id2] : Node::nil;
+    Node *separator = newNode(op.args[1]);
+    Node *result = join(t1, separator, t2);
+    trees[id] = result;          // Store result in first tree's ID.
+    trees[id2] = Node::nil;     // Clear second tree's ID.
+    break;
+  }
+  case 6: {
+    // Split.
+    if (trees.count(id) > 0) {
+      auto [left, x, right] = split(trees[id], op.args[1]);
+      out << "-------- L --------" << std::endl;
+      print(left, out);
+      out << "-------- x --------" << std::endl;
+      print(x, out);
+      out << "-------- R --------" << std::endl;
+      print(right, out);
+      out << "-------------------" << std::endl;
+      // Optionally store the split results.
+      trees[id] = Node::nil;     // Clear original tree's ID.
+    } else {
+      out << "Invalid ID" << std::endl;
     }
-    case 6: {
-      // Split.
-      std::cin >> id >> key;
-      if (trees.count(id) > 0) {
-        auto [left, x, right] = split(trees[id], key);
-        std::cout << "-------- L --------" << std::endl;
-        print(left);
-        std::cout << "-------- x --------" << std::endl;
-        print(x);
-        std::cout << "-------- R --------" << std::endl;
-        print(right);
-        std::cout << "-------------------" << std::endl;
-        // Optionally store the split results.
-        trees[id] = Node::nil;     // Clear original tree's ID.
-      } else {
-        std::cout << "Invalid ID" << std::endl;
-      }
-      break;
+    break;
+  }
+  case 7: {
+    // Print.
+    if (trees.count(id) > 0) {
+      print(trees[id], out);
+    } else {
+      out << "Invalid ID" << std::endl;
     }
-    case 7: {
-      // Print.
-      std::cin >> id;
-      if (trees.count(id) > 0) {
-        print(trees[id]);
-      } else {
-        std::cout << "Invalid ID" << std::endl;
+    break;
+  }
+  case 8: {
+    // Rank.
+    Node *tree = (trees.count(id) > 0) ? trees[id] : Node::nil;
+    out << rank(tree, op.args[1]) << std::endl;
+    break;
+  }
+  case 9: {
+    // Select.
+    Node *tree = (trees.count(id) > 0) ? trees[id] : Node::nil;
+    Node *x = select(tree, op.args[1]);
+    if (x == Node::nil)
+      out << "Invalid rank" << std::endl;
+    else
+      out << x->key << std::endl;
+    break;
+  }
+  case 10: {
+    // Load.
+    KeyFile file;
+    if (file.open(op.path.c_str()))
+      trees[id] = build(file.data(), file.size());
+    else
+      out << "Invalid key file " << op.path << std::endl;
+    break;
+  }
+  default:
+    out << "Invalid Operation" << std::endl;
+    break;
+  }
+}
+
+/**
+ * @brief Finds the representative of the given group in a union-find forest, compressing the path.
+ *
+ * @param parent The union-find forest.
+ * @param x The group.
+ * @return The group representative.
+ */
+int find(std::vector<int> &parent, int x) {
+  while (parent[x] != x)
+    x = parent[x] = parent[parent[x]];
+  return x;
+}
+
+/**
+ * @brief Replays the given script on a pool of worker threads. The operations are partitioned into groups of trees that
+ * interact through joins, each group is replayed in order by one worker, and the outputs are printed in script order.
+ *
+ * @param ops The script operations.
+ * @param threads The number of worker threads.
+ */
+void replayParallel(const std::vector<Operation> &ops, unsigned threads) {
+  // group the tree ids: a join puts its two trees in the same group.
+  std::unordered_map<int, int> index;
+  std::vector<int> parent;
+  auto groupOf = [&](int id) {
+    auto [it, added] = index.emplace(id, parent.size());
+    if (added)
+      parent.push_back(it->second);
+    return it->second;
+  };
+  for (const Operation &op : ops) {
+    if (arity(op.code) == 0)
+      continue;
+    int g = groupOf(op.args[0]);
+    if (op.code == 5)
+      parent[find(parent, groupOf(op.args[2]))] = find(parent, g);
+  }
+
+  std::vector<std::vector<int>> groups(parent.size());
+  std::vector<std::string> outputs(ops.size());
+  for (size_t i = 0; i < ops.size(); i++) {
+    if (arity(ops[i].code) == 0)
+      outputs[i] = "Invalid Operation\n";
+    else
+      groups[find(parent, index[ops[i].args[0]])].push_back(i);
+  }
+  groups.erase(std::remove_if(groups.begin(), groups.end(), [](const std::vector<int> &g) { return g.empty(); }), groups.end());
+  std::sort(groups.begin(), groups.end(), [](const std::vector<int> &a, const std::vector<int> &b) { return a.size() > b.size(); });
+
+  // the largest groups are taken first, which balances the workers.
+  std::atomic<size_t> next(0);
+  auto worker = [&] {
+    for (size_t g = next++; g < groups.size(); g = next++) {
+      std::map<int, Node *> trees;
+      std::ostringstream out;
+      for (int i : groups[g]) {
+        apply(ops[i], trees, out);
+        outputs[i] = out.str();
+        out.str("");
       }
-      break;
     }
-    default:
-      std::cout << "Invalid Operation" << std::endl;
-      break;
+  };
+  std::vector<std::thread> pool;
+  for (unsigned t = 1; t < threads; t++)
+    pool.emplace_back(worker);
+  worker();
+  for (std::thread &t : pool)
+    t.join();
+
+  for (const std::string &output : outputs)
+    std::cout << output;
+  std::cout.flush();
+}
+
+int main(int argc, char **argv) {
+  if (argc != 1 && argc != 3) {
+    std::cerr << "usage: " << argv[0] << " [-j <threads>]" << std::endl;
+    return 1;
+  }
+  if (argc == 3) {
+    char *end;
+    errno = 0;
+    unsigned long n = std::strtoul(argv[2], &end, 10);
+    // strtoul accepts a sign and negates the value, so -1 would wrap to a huge count.
+    if (std::strcmp(argv[1], "-j") != 0 || end == argv[2] || *end != '\0' || std::strchr(argv[2], '-') ||
+        errno == ERANGE || n > MAX_THREADS) {
+      std::cerr << "usage: " << argv[0] << " [-j <threads>], with 0 <= threads <= " << MAX_THREADS << std::endl;
+      return 1;
     }
+    unsigned threads = (unsigned)n;
+    if (threads == 0)
+      threads = std::max(std::thread::hardware_concurrency(), 1u);
+
+    std::ios::sync_with_stdio(false);
+    std::vector<Operation> ops;
+    for (Operation op; readOperation(std::cin, op);)
+      ops.push_back(op);
+    replayParallel(ops, threads);
+    return 0;
   }
 
+  std::map<int, Node *> trees;     // Map to store trees by ID.
+  Operation op;
+
+  while (readOperation(std::cin, op))
+    apply(op, trees, std::cout);
+
   return 0;
 }
\ No newline at end of file
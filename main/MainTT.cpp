@@ -28,21 +28,39 @@
  *      False
  *      True
  *
+ * The tree can also be built from a binary key file, given as the only argument: a raw array of 32-bit integers, sorted
+ * and without duplicates. The file is memory mapped and the tree is built in parallel straight from it, then the keys
+ * are read from the standard input as above (the tree is not printed).
+ *
+ *      MainTT keys.bin < queries.txt
+ *
  * Note:
  * This is a kind of a silly test, but can be used to show the power of the Tango Tree to perform a sequence of access.
  */
 
 // includes.
+#include "KeyFile.h"
 #include "TangoTree.h"
 #include <iostream>
+#include <memory>
 
-int main() {
+int main(int argc, char **argv) {
   int n, key;
-  std::cin >> n;
-  TangoTree t = TangoTree(n);
-
-  t.show();
-  std::cout << "----" << std::endl;
+  std::unique_ptr<TangoTree> tree;
+  if (argc == 2) {
+    KeyFile file;
+    if (!file.open(argv[1])) {
+      std::cerr << "Invalid key file " << argv[1] << std::endl;
+      return 1;
+    }
+    tree.reset(new TangoTree(file.data(), file.size()));
+  } else {
+    std::cin >> n;
+    tree.reset(new TangoTree(n));
+    tree->show();
+    std::cout << "----" << std::endl;
+  }
+  TangoTree &t = *tree;
 
   while (std::cin >> key) {
     std::cout << (t.contains(key) ? "True" : "False") << std::endl;
@@ -0,0 +1,298 @@
+/**
+ * @file tangod.cpp
+ * @author Zawarudo (@zawarudo)
+ * @version 1.0
+ * @date 2026-10-18
+ * @copyright Copyright (c) 2026
+ *
+ * A local query server owning one or more Tango Trees. It listens on a Unix domain socket and serves a binary protocol,
+ * so that several processes can share the trees without going through MainTT.
+ *
+ * How to use it:
+ *      tangod <socket> <tree>...
+ * Each <tree> is either an integer n, for a tree with the keys 1 to n, or the path of a binary key file (see KeyFile.h).
+ * The trees are numbered from 0 in the order given.
+ *
+ * Protocol:
+ * A request is 8 bytes: the operation (1 byte), the tree number (1 byte), 2 reserved bytes and the key (32-bit integer in
+ * the host byte order, the socket is local). The operations are
+ *
+ *      1 contains      2 insert      3 erase
+ *
+ * A response is 1 byte: 1 for true, 0 for false and 255 for an invalid request. Responses are sent in request order.
+ *
+ * A client may pipeline any number of requests. Every read drains the socket and the consecutive contains requests on the
+ * same tree are answered as one batch, through TangoTree::containsBatch. The server runs one epoll loop on one thread.
+ */
+
+// includes.
+#include "KeyFile.h"
+#include "TangoTree.h"
+#include <cerrno>
+#include <climits>
+#include <csignal>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <memory>
+#include <sys/epoll.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+#include <unordered_map>
+#include <vector>
+
+// defines.
+#define REQUEST_SIZE 8           // bytes per request.
+#define READ_CHUNK (1 << 16)     // bytes read from a socket at once.
+#define READ_CHUNKS 16           // chunks read from a socket per event.
+#define MAX_PENDING (1 << 20)    // response bytes pending on a connection before its requests stop being read.
+
+/**
+ * @brief Enum to encode the request operations.
+ */
+enum Operation : uint8_t { CONTAINS = 1, INSERT = 2, ERASE = 3 };
+
+/**
+ * @brief Struct to represent a client connection and its buffers.
+ */
+struct Connection {
+  int fd;                      // The connection socket.
+  std::vector<char> input;     // The bytes received and not parsed yet (at most one partial request).
+  std::vector<char> output;    // The responses not sent yet.
+  size_t sent = 0;             // The number of output bytes already sent.
+  bool eof = false;            // Flag to indicate that the client is done sending.
+};
+
+/**
+ * @brief Struct to represent a decoded request.
+ */
+struct Request {
+  uint8_t op;     // The operation.
+  uint8_t tree;   // The tree number.
+  int key;        // The key.
+};
+
+/**
+ * @brief Decodes the request stored at the given position.
+ *
+ * @param p The request bytes.
+ * @return The request.
+ */
+Request decode(const char *p) {
+  Request r;
+  r.op = (uint8_t)p[0];
+  r.tree = (uint8_t)p[1];
+  std::memcpy(&r.key, p + 4, sizeof(int));
+  return r;
+}
+
+/**
+ * @brief Answers all the complete requests in the connection input, appending the responses to its output. Runs of
+ * contains requests on the same tree are answered with one batch lookup.
+ *
+ * @param c The connection.
+ * @param trees The served trees.
+ */
+void serve(Connection &c, std::vector<std::unique_ptr<TangoTree>> &trees) {
+  size_t m = c.input.size() / REQUEST_SIZE;
+  std::vector<int> keys;
+  std::unique_ptr<bool[]> found;
+  size_t capacity = 0;
+
+  for (size_t i = 0; i < m;) {
+    Request r = decode(&c.input[i * REQUEST_SIZE]);
+    if (r.tree >= trees.size() || r.op < CONTAINS || r.op > ERASE) {
+      c.output.push_back((char)255);
+      i++;
+      continue;
+    }
+    TangoTree &t = *trees[r.tree];
+    if (r.op != CONTAINS) {
+      c.output.push_back(r.op == INSERT ? t.insert(r.key) : t.erase(r.key));
+      i++;
+      continue;
+    }
+
+    // gather the run of contains requests on this tree.
+    keys.clear();
+    size_t j = i;
+    for (; j < m; j++) {
+      Request q = decode(&c.input[j * REQUEST_SIZE]);
+      if (q.op != CONTAINS || q.tree != r.tree)
+        break;
+      keys.push_back(q.key);
+    }
+    if (keys.size() > capacity) {
+      capacity = keys.size();
+      found.reset(new bool[capacity]);
+    }
+    t.containsBatch(keys.data(), keys.size(), found.get());
+    for (size_t k = 0; k < keys.size(); k++)
+      c.output.push_back(found[k]);
+    i = j;
+  }
+  c.input.erase(c.input.begin(), c.input.begin() + m * REQUEST_SIZE);
+}
+
+/**
+ * @brief Sends as much of the pending output of the connection as the socket accepts.
+ *
+ * @param c The connection.
+ * @return false if the connection failed, true otherwise.
+ */
+bool flush(Connection &c) {
+  while (c.sent < c.output.size()) {
+    ssize_t w = send(c.fd, c.output.data() + c.sent, c.output.size() - c.sent, MSG_NOSIGNAL);
+    if (w < 0)
+      return errno == EAGAIN || errno == EWOULDBLOCK;
+    c.sent += w;
+  }
+  c.output.clear();
+  c.sent = 0;
+  return true;
+}
+
+/**
+ * @brief Sets the epoll events of the connection: its requests are read while its pending output is small and the
+ * client may still send, and the socket is watched for writing while there is pending output.
+ *
+ * @param epfd The epoll instance.
+ * @param c The connection.
+ */
+void watch(int epfd, Connection &c) {
+  epoll_event ev{};
+  size_t pending = c.output.size() - c.sent;
+  uint32_t events = 0;
+  if (!c.eof && pending < MAX_PENDING)
+    events |= EPOLLIN;
+  if (pending > 0)
+    events |= EPOLLOUT;
+  ev.events = events;
+  ev.data.fd = c.fd;
+  epoll_ctl(epfd, EPOLL_CTL_MOD, c.fd, &ev);
+}
+
+/**
+ * @brief Reads the available requests of the connection, up to READ_CHUNKS chunks, and answers them.
+ *
+ * @param c The connection.
+ * @param trees The served trees.
+ * @return false if the connection failed, true otherwise. A client that is done sending sets eof.
+ */
+bool receive(Connection &c, std::vector<std::unique_ptr<TangoTree>> &trees) {
+  for (int chunk = 0; chunk < READ_CHUNKS; chunk++) {     // level triggered: the rest is read on the next round.
+    size_t used = c.input.size();
+    c.input.resize(used + READ_CHUNK);
+    ssize_t r = recv(c.fd, c.input.data() + used, READ_CHUNK, 0);
+    c.input.resize(used + std::max<ssize_t>(r, 0));
+    if (r == 0)
+      c.eof = true;     // the client is done sending, its last requests are still answered.
+    if (r < 0 && errno != EAGAIN && errno != EWOULDBLOCK)
+      return false;
+    if (r <= 0)
+      break;
+  }
+  serve(c, trees);
+  return flush(c);
+}
+
+int main(int argc, char **argv) {
+  if (argc < 3) {
+    std::cerr << "usage: " << argv[0] << " <socket> <tree>..." << std::endl;
+    return 1;
+  }
+  if (argc - 2 > 255) {     // the tree number is one byte and 255 marks an invalid request.
+    std::cerr << "At most 255 trees can be served" << std::endl;
+    return 1;
+  }
+
+  std::vector<std::unique_ptr<TangoTree>> trees;
+  for (int i = 2; i < argc; i++) {
+    char *end;
+    errno = 0;
+    long n = std::strtol(argv[i], &end, 10);
+    if (end != argv[i] && *end == '\0') {     // a number, not a file name.
+      if (errno == ERANGE || n < 0 || n > INT_MAX) {
+        std::cerr << "Invalid tree size " << argv[i] << std::endl;
+        return 1;
+      }
+      trees.emplace_back(new TangoTree((int)n));
+      continue;
+    }
+    KeyFile file;
+    if (!file.open(argv[i])) {
+      std::cerr << "Invalid key file " << argv[i] << std::endl;
+      return 1;
+    }
+    trees.emplace_back(new TangoTree(file.data(), file.size()));
+  }
+
+  sockaddr_un addr{};
+  addr.sun_family = AF_UNIX;
+  if (std::strlen(argv[1]) >= sizeof(addr.sun_path)) {
+    std::cerr << "Socket path too long" << std::endl;
+    return 1;
+  }
+  std::strcpy(addr.sun_path, argv[1]);
+  unlink(argv[1]);
+
+  int listener = socket(AF_UNIX, SOCK_STREAM | SOCK_NONBLOCK, 0);
+  if (listener < 0 || bind(listener, (sockaddr *)&addr, sizeof(addr)) < 0 || listen(listener, SOMAXCONN) < 0) {
+    std::cerr << "Can not listen on " << argv[1] << ": " << std::strerror(errno) << std::endl;
+    return 1;
+  }
+  std::signal(SIGPIPE, SIG_IGN);
+
+  int epfd = epoll_create1(0);
+  epoll_event ev{};
+  ev.events = EPOLLIN;
+  ev.data.fd = listener;
+  if (epfd < 0 || epoll_ctl(epfd, EPOLL_CTL_ADD, listener, &ev) < 0) {
+    std::cerr << "Can not watch " << argv[1] << ": " << std::strerror(errno) << std::endl;
+    return 1;
+  }
+
+  std::unordered_map<int, Connection> connections;
+  std::vector<epoll_event> events(64);
+  for (;;) {
+    int k = epoll_wait(epfd, events.data(), events.size(), -1);
+    if (k < 0 && errno == EINTR)
+      continue;
+    if (k < 0) {
+      std::cerr << "Can not wait for events: " << std::strerror(errno) << std::endl;
+      return 1;
+    }
+    for (int e = 0; e < k; e++) {
+      int fd = events[e].data.fd;
+      if (fd == listener) {
+        for (int client; (client = accept4(listener, nullptr, nullptr, SOCK_NONBLOCK)) >= 0;) {
+          epoll_event cev{};
+          cev.events = EPOLLIN;
+          cev.data.fd = client;
+          if (epoll_ctl(epfd, EPOLL_CTL_ADD, client, &cev) < 0) {     // the client can not be served.
+            close(client);
+            continue;
+          }
+          connections[client].fd = client;
+        }
+        continue;
+      }
+
+      Connection &c = connections[fd];
+      bool alive = !(events[e].events & EPOLLERR);
+      if (alive && (events[e].events & EPOLLOUT))
+        alive = flush(c);
+      if (alive && !c.eof && (events[e].events & (EPOLLIN | EPOLLHUP)) && c.output.size() - c.sent < MAX_PENDING)
+        alive = receive(c, trees);
+      if (!alive || (c.eof && c.sent == c.output.size())) {     // failed, or every response was sent.
+        epoll_ctl(epfd, EPOLL_CTL_DEL, fd, nullptr);
+        close(fd);
+        connections.erase(fd);
+      } else {
+        watch(epfd, c);
+      }
+    }
+  }
+}
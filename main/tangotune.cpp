@@ -0,0 +1,59 @@
+/**
+ * @file tangotune.cpp
+ * @author Zawarudo (@zawarudo)
+ * @version 1.0
+ * @date 2026-10-18
+ * @copyright Copyright (c) 2026
+ *
+ * Calibrates the Tango Tree knobs for the current host and writes them to a configuration file, to be named by the
+ * TANGOTREE_CONFIG environment variable of the programs building trees (see TangoConfig in TangoTree.h).
+ *
+ * How to use it:
+ *      tangotune <config> [n]
+ * n is the number of keys of the benchmark trees (32768 by default). When the file already exists, the knobs that
+ * depend on the workload (fingers, coldAge and biased) are kept from it and the others are replaced.
+ */
+
+// includes.
+#include "TangoTune.h"
+#include <cerrno>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <sys/stat.h>
+
+int main(int argc, char **argv) {
+  if (argc < 2 || argc > 3) {
+    std::cerr << "usage: " << argv[0] << " <config> [n]" << std::endl;
+    return 1;
+  }
+  int n = argc == 3 ? std::atoi(argv[2]) : 1 << 15;
+  if (n <= 0) {
+    std::cerr << "Invalid size " << argv[2] << std::endl;
+    return 1;
+  }
+
+  TangoConfig base;
+  if (!loadConfig(argv[1], base)) {
+    // only a missing file starts from the built-in configuration, a malformed or unreadable one is not replaced.
+    struct stat info;
+    if (stat(argv[1], &info) == 0) {
+      std::cerr << "Invalid configuration " << argv[1] << std::endl;
+      return 1;
+    }
+    if (errno != ENOENT) {
+      std::cerr << "Can not read " << argv[1] << ": " << std::strerror(errno) << std::endl;
+      return 1;
+    }
+  }
+  TangoConfig config = calibrate(n, base);
+  if (!saveConfig(argv[1], config)) {
+    std::cerr << "Can not write " << argv[1] << std::endl;
+    return 1;
+  }
+  std::cout << "cacheSets = " << config.cacheSets << std::endl;
+  std::cout << "filterBits = " << config.filterBits << std::endl;
+  std::cout << "parallelCutoff = " << config.parallelCutoff << std::endl;
+  std::cout << "slabBytes = " << config.slabBytes << std::endl;
+  return 0;
+}
@@ -0,0 +1,139 @@
+/**
+ * @file BiasedTree.cpp
+ * @author Zawarudo (@zawarudo)
+ * @version 1.0
+ * @date 2026-10-18
+ * @copyright Copyright (c) 2026
+ *
+ * Implementation of the biased auxiliary trees defined in BiasedTree.h. The keys are in search tree order and the
+ * priorities in max-heap order; every structural change ends with update on the touched nodes, as in the red-black
+ * trees, so that the subtree fields stay valid.
+ */
+
+// includes.
+#include "BiasedTree.h"
+
+const AuxiliaryTree BiasedAuxiliary = {biasedJoin, biasedSplit, biasedDeleteMin, biasedDeleteMax};
+
+/* Auxiliary functions. */
+
+/**
+ * @brief Returns the priority of the given node: its heat, with a hash of its key breaking the ties.
+ *
+ * @param h The node.
+ * @return The node priority.
+ */
+unsigned priority(const Node *h) { return (unsigned)h->heat << 16 | ((unsigned)h->key * 2654435769u) >> 16; }
+
+/**
+ * @brief Rotates the given subtree right, lifting its left child.
+ *
+ * @param h The subtree root.
+ * @return The new subtree root.
+ */
+Node *liftLeft(Node *h) {
+  Node *x = h->left;
+  h->left = x->right;
+  x->right = h;
+  update(h);
+  update(x);
+  return x;
+}
+
+/**
+ * @brief Rotates the given subtree left, lifting its right child.
+ *
+ * @param h The subtree root.
+ * @return The new subtree root.
+ */
+Node *liftRight(Node *h) {
+  Node *x = h->right;
+  h->right = x->left;
+  x->left = h;
+  update(h);
+  update(x);
+  return x;
+}
+
+/* BiasedJoin. */
+Node *biasedJoin(Node *leftTree, Node *x, Node *rightTree) {
+  bool leftFirst = !leftTree->isExternal && (rightTree->isExternal || priority(leftTree) > priority(rightTree));
+  if (leftFirst && priority(leftTree) > priority(x)) {
+    leftTree->right = biasedJoin(leftTree->right, x, rightTree);
+    update(leftTree);
+    return leftTree;
+  }
+  if (!rightTree->isExternal && priority(rightTree) > priority(x)) {
+    rightTree->left = biasedJoin(leftTree, x, rightTree->left);
+    update(rightTree);
+    return rightTree;
+  }
+  x->left = leftTree;
+  x->right = rightTree;
+  x->isExternal = false;
+  update(x);
+  return x;
+}
+
+/* BiasedSplit. */
+std::tuple<Node *, Node *, Node *> biasedSplit(Node *h, int key) {
+  if (key < h->key) {
+    auto [left, x, right] = biasedSplit(h->left, key);
+    h->left = right;
+    update(h);
+    return {left, x, h};
+  }
+  if (key > h->key) {
+    auto [left, x, right] = biasedSplit(h->right, key);
+    h->right = left;
+    update(h);
+    return {h, x, right};
+  }
+  Node *left = h->left, *right = h->right;
+  h->left = h->right = Node::nil;
+  return {left, h, right};
+}
+
+/* BiasedDeleteMin. */
+std::pair<Node *, Node *> biasedDeleteMin(Node *root) {
+  if (root->left->isExternal)
+    return {root, root->right};     // the min node keeps its left external child, its right subtree takes its place.
+  auto [min, h] = biasedDeleteMin(root->left);
+  root->left = h;
+  update(root);
+  return {min, root};
+}
+
+/* BiasedDeleteMax. */
+std::pair<Node *, Node *> biasedDeleteMax(Node *root) {
+  if (root->right->isExternal)
+    return {root, root->left};
+  auto [max, h] = biasedDeleteMax(root->right);
+  root->right = h;
+  update(root);
+  return {max, root};
+}
+
+/* BiasedTouch. */
+Node *biasedTouch(Node *root, int key) {
+  if (key == root->key) {
+    if (root->heat < 0xffff)
+      root->heat++;
+    return root;
+  }
+  if (key < root->key) {
+    root->left = biasedTouch(root->left, key);
+    return priority(root->left) > priority(root) ? liftLeft(root) : root;
+  }
+  root->right = biasedTouch(root->right, key);
+  return priority(root->right) > priority(root) ? liftRight(root) : root;
+}
+
+/* Decay. */
+void decay(Node *h) {
+  if (h == Node::nil || h->isCold || h->refs > 1)     // a subtree shared with a fork keeps its heat.
+    return;
+  h->heat >>= 1;
+  decay(h->left);
+  decay(h->right);
+}
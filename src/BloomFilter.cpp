@@ -0,0 +1,61 @@
+/**
+ * @file BloomFilter.cpp
+ * @author Zawarudo (@zawarudo)
+ * @version 1.0
+ * @date 2026-10-18
+ * @copyright Copyright (c) 2026
+ *
+ * Implementation of the blocked Bloom filter defined in BloomFilter.h. A key is hashed once to 64 bits: the high half
+ * selects the block and the low half, multiplied by eight odd salts, selects one bit in each word of the block.
+ */
+
+// includes.
+#include "BloomFilter.h"
+
+/* Auxiliary functions. */
+
+/**
+ * @brief Mixes the bits of the given key into a 64-bit hash (the splitmix64 finalizer).
+ *
+ * @param key The key.
+ * @return The key hash.
+ */
+uint64_t mixKey(int key) {
+  uint64_t h = (uint64_t)(uint32_t)key + 0x9E3779B97F4A7C15ull;
+  h = (h ^ (h >> 30)) * 0xBF58476D1CE4E5B9ull;
+  h = (h ^ (h >> 27)) * 0x94D049BB133111EBull;
+  return h ^ (h >> 31);
+}
+
+/**
+ * @brief Odd salts used to pick one bit per block word from the low half of the key hash.
+ */
+const uint32_t SALTS[8] = {0x47b6137bu, 0x44974d91u, 0x8824ad5bu, 0xa2b7289du, 0x705495c7u, 0x2df1424bu, 0x9efc4947u, 0x5c6bfb31u};
+
+/* Constructor. */
+BloomFilter::BloomFilter(int n, int bitsPerKey) : capacity(n) {
+  if (bitsPerKey <= 0)
+    return;
+  long long blocks = ((long long)n * bitsPerKey + 511) / 512;
+  words.assign(8 * (blocks > 0 ? blocks : 1), 0);
+}
+
+/* Add. */
+void BloomFilter::add(int key) {
+  uint64_t h = mixKey(key);
+  uint64_t *block = &words[8 * (((h >> 32) * (words.size() / 8)) >> 32)];     // map the high half onto the blocks.
+  for (int i = 0; i < 8; i++)
+    block[i] |= 1ull << (((uint32_t)h * SALTS[i]) >> 26);
+}
+
+/* MayContain. */
+bool BloomFilter::mayContain(int key) const {
+  if (words.empty())
+    return false;
+  uint64_t h = mixKey(key);
+  const uint64_t *block = &words[8 * (((h >> 32) * (words.size() / 8)) >> 32)];
+  uint64_t miss = 0;
+  for (int i = 0; i < 8; i++)     // branch free, the compiler turns it into a few vector operations.
+    miss |= ~block[i] & (1ull << (((uint32_t)h * SALTS[i]) >> 26));
+  return miss == 0;
+}
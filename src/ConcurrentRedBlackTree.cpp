@@ -0,0 +1,289 @@
+/**
+ * @file ConcurrentRedBlackTree.cpp
+ * @author Zawarudo (@zawarudo)
+ * @version 1.0
+ * @date 2026-10-18
+ * @copyright Copyright (c) 2026
+ *
+ * Implementation of the concurrent red-black tree defined in ConcurrentRedBlackTree.h. The writers run the algorithms of
+ * RedBlackTree.cpp (the recursive insert and the bottom-up popFront) on versioned nodes.
+ */
+
+// includes.
+#include "ConcurrentRedBlackTree.h"
+#include <thread>
+
+// defines.
+#define RECLAIM_BATCH 64     // number of removed nodes that makes a writer wait for the searches in flight and release them.
+
+/* Auxiliary functions. */
+
+/**
+ * @brief Waits until the given version is unlocked and returns it.
+ *
+ * @param version The version of a node or of the root pointer.
+ * @return The even version.
+ */
+unsigned long readLock(const std::atomic<unsigned long> &version) {
+  unsigned long v;
+  for (int spins = 0; ((v = version.load(std::memory_order_acquire)) & 1) != 0; spins++)
+    if (spins >= 64)
+      std::this_thread::yield();     // the writer holds the lock until the end of its operation.
+  return v;
+}
+
+/**
+ * @brief Checks that the given version did not change since it was read, so that the fields read in between are
+ * consistent.
+ *
+ * @param version The version of a node or of the root pointer.
+ * @param v The version read by readLock.
+ * @return true if the version is unchanged, false otherwise.
+ */
+bool validate(const std::atomic<unsigned long> &version, unsigned long v) {
+  std::atomic_thread_fence(std::memory_order_acquire);
+  return version.load(std::memory_order_relaxed) == v;
+}
+
+/**
+ * @brief Checks if the given node is red. A missing child is black.
+ *
+ * @param h The node, or nullptr.
+ * @return true if the node is red, false otherwise.
+ */
+template <typename NodeT>
+bool isRed(const NodeT *h) {
+  return h != nullptr && h->color == RED;
+}
+
+/**
+ * @brief Releases the given subtree.
+ *
+ * @param h The subtree root, or nullptr.
+ */
+template <typename NodeT>
+void destroy(NodeT *h) {
+  if (h == nullptr)
+    return;
+  destroy(h->left.load(std::memory_order_relaxed));
+  destroy(h->right.load(std::memory_order_relaxed));
+  delete h;
+}
+
+/* Constructor. */
+ConcurrentRedBlackTree::ConcurrentRedBlackTree() : root(nullptr), rootVersion(0), count(0), epoch(0) {}
+
+/* Destructor. */
+ConcurrentRedBlackTree::~ConcurrentRedBlackTree() {
+  destroy(root.load(std::memory_order_relaxed));
+  for (Node *x : retired)
+    delete x;
+}
+
+/* Enter. */
+std::atomic<long> &ConcurrentRedBlackTree::enter() const {
+  static std::atomic<unsigned> nextSlot(0);
+  thread_local unsigned slot = nextSlot.fetch_add(1, std::memory_order_relaxed) % READER_SLOTS;
+  while (true) {
+    unsigned e = epoch.load();
+    std::atomic<long> &n = readers[e & 1][slot].n;
+    n.fetch_add(1);
+    if (epoch.load() == e)     // registered before any later flip, which then waits for the search.
+      return n;
+    n.fetch_sub(1, std::memory_order_release);
+  }
+}
+
+/* Reclaim. */
+void ConcurrentRedBlackTree::reclaim() {
+  // the retired nodes are unreachable, so only the searches registered in the older epoch may hold them.
+  unsigned e = epoch.fetch_add(1);
+  for (Counter &c : readers[e & 1])
+    while (c.n.load(std::memory_order_acquire) > 0)
+      std::this_thread::yield();
+  for (Node *x : retired)
+    delete x;
+  retired.clear();
+}
+
+/* TryContains. */
+int ConcurrentRedBlackTree::tryContains(int key) const {
+  const std::atomic<unsigned long> *version = &rootVersion;     // the version of the pointer h was read from.
+  unsigned long v = readLock(rootVersion);
+  Node *h = root.load(std::memory_order_acquire);
+  while (h != nullptr) {
+    unsigned long hv = readLock(h->version);
+    if (!validate(*version, v))     // h is no longer the child: the path changed.
+      return -1;
+    if (key == h->key)
+      return 1;
+    version = &h->version;
+    v = hv;
+    h = (key < h->key ? h->left : h->right).load(std::memory_order_acquire);
+  }
+  return validate(*version, v) ? 0 : -1;
+}
+
+/* Contains. */
+bool ConcurrentRedBlackTree::contains(int key) const {
+  std::atomic<long> &registration = enter();
+  int found;
+  while ((found = tryContains(key)) < 0)
+    ;
+  registration.fetch_sub(1, std::memory_order_release);
+  return found == 1;
+}
+
+/* Lock. */
+void ConcurrentRedBlackTree::lock(std::atomic<unsigned long> &version) {
+  unsigned long v = version.load(std::memory_order_relaxed);
+  if ((v & 1) != 0)
+    return;     // the writers run one at a time, so the lock is ours.
+  version.store(v + 1, std::memory_order_relaxed);
+  std::atomic_thread_fence(std::memory_order_release);     // a search reading a changed child sees the odd version.
+  locked.push_back(&version);
+}
+
+/* UnlockAll. */
+void ConcurrentRedBlackTree::unlockAll() {
+  for (std::atomic<unsigned long> *version : locked)
+    version->store(version->load(std::memory_order_relaxed) + 1, std::memory_order_release);
+  locked.clear();
+}
+
+/* SetChild. */
+void ConcurrentRedBlackTree::setChild(Node *h, std::atomic<Node *> &child, Node *x) {
+  if (child.load(std::memory_order_relaxed) == x)
+    return;
+  lock(h->version);
+  child.store(x, std::memory_order_release);
+}
+
+/* RotateLeft. */
+ConcurrentRedBlackTree::Node *ConcurrentRedBlackTree::rotateLeft(Node *h) {
+  Node *x = h->right.load(std::memory_order_relaxed);
+  setChild(h, h->right, x->left.load(std::memory_order_relaxed));
+  setChild(x, x->left, h);
+  x->color = h->color;
+  h->color = RED;
+  return x;
+}
+
+/* RotateRight. */
+ConcurrentRedBlackTree::Node *ConcurrentRedBlackTree::rotateRight(Node *h) {
+  Node *x = h->left.load(std::memory_order_relaxed);
+  setChild(h, h->left, x->right.load(std::memory_order_relaxed));
+  setChild(x, x->right, h);
+  x->color = h->color;
+  h->color = RED;
+  return x;
+}
+
+/* Balance. */
+ConcurrentRedBlackTree::Node *ConcurrentRedBlackTree::balance(Node *h) {
+  if (isRed(h->right.load(std::memory_order_relaxed)))
+    h = rotateLeft(h);     // fix right-leaning red link.
+  Node *l = h->left.load(std::memory_order_relaxed);
+  if (isRed(l) && isRed(l->left.load(std::memory_order_relaxed)))
+    h = rotateRight(h);     // fix two reds in a row on the left.
+  l = h->left.load(std::memory_order_relaxed);
+  Node *r = h->right.load(std::memory_order_relaxed);
+  if (isRed(l) && isRed(r)) {     // split 4-node, the colors are not read by searches.
+    h->color = RED;
+    l->color = r->color = BLACK;
+  }
+  return h;
+}
+
+/* InsertRec. */
+ConcurrentRedBlackTree::Node *ConcurrentRedBlackTree::insertRec(Node *h, int key, bool &inserted) {
+  if (h == nullptr) {
+    inserted = true;
+    return new Node(key);     // published by the store of the parent's child.
+  }
+  if (key < h->key)
+    setChild(h, h->left, insertRec(h->left.load(std::memory_order_relaxed), key, inserted));
+  else if (key > h->key)
+    setChild(h, h->right, insertRec(h->right.load(std::memory_order_relaxed), key, inserted));
+  else
+    return h;
+  return balance(h);
+}
+
+/* Insert. */
+bool ConcurrentRedBlackTree::insert(int key) {
+  std::lock_guard<std::mutex> guard(writer);
+  bool inserted = false;
+  Node *r = root.load(std::memory_order_relaxed);
+  Node *h = insertRec(r, key, inserted);
+  h->color = BLACK;
+  if (h != r) {
+    lock(rootVersion);
+    root.store(h, std::memory_order_release);
+  }
+  unlockAll();
+  if (inserted)
+    count.fetch_add(1, std::memory_order_relaxed);
+  return inserted;
+}
+
+/* FixShortLeft. */
+std::pair<ConcurrentRedBlackTree::Node *, bool> ConcurrentRedBlackTree::fixShortLeft(Node *h) {
+  Node *l = h->left.load(std::memory_order_relaxed);
+  Node *s = h->right.load(std::memory_order_relaxed);
+  if (isRed(l)) {     // a red root makes up for the missing black node.
+    l->color = BLACK;
+    return {h, false};
+  }
+  Node *x = s->left.load(std::memory_order_relaxed);
+  if (isRed(x)) {     // borrow from the 3-node sibling.
+    setChild(h, h->right, x->left.load(std::memory_order_relaxed));
+    setChild(s, s->left, x->right.load(std::memory_order_relaxed));
+    setChild(x, x->left, h);
+    setChild(x, x->right, s);
+    x->color = h->color;
+    h->color = BLACK;
+    return {x, false};
+  }
+  bool isShort = h->color == BLACK;     // merge with the 2-node sibling.
+  setChild(h, h->right, x);
+  setChild(s, s->left, h);
+  h->color = RED;
+  return {s, isShort};
+}
+
+/* DeleteMinRec. */
+std::tuple<ConcurrentRedBlackTree::Node *, ConcurrentRedBlackTree::Node *, bool> ConcurrentRedBlackTree::deleteMinRec(Node *h) {
+  Node *l = h->left.load(std::memory_order_relaxed);
+  if (l == nullptr)
+    return {h, h->right.load(std::memory_order_relaxed), h->color == BLACK};
+  auto [min, x, isShort] = deleteMinRec(l);
+  setChild(h, h->left, x);
+  if (!isShort)
+    return {min, h, false};
+  auto [y, stillShort] = fixShortLeft(h);
+  return {min, y, stillShort};
+}
+
+/* DeleteMin. */
+bool ConcurrentRedBlackTree::deleteMin(int &key) {
+  std::lock_guard<std::mutex> guard(writer);
+  Node *r = root.load(std::memory_order_relaxed);
+  if (r == nullptr)
+    return false;
+  auto [min, h, isShort] = deleteMinRec(r);
+  if (h != nullptr)
+    h->color = BLACK;
+  if (h != r) {
+    lock(rootVersion);
+    root.store(h, std::memory_order_release);
+  }
+  unlockAll();
+  count.fetch_sub(1, std::memory_order_relaxed);
+
+  key = min->key;
+  retired.push_back(min);     // a search may still be reading it.
+  if (retired.size() >= RECLAIM_BATCH)
+    reclaim();
+  return true;
+}
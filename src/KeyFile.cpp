@@ -0,0 +1,63 @@
+/**
+ * @file KeyFile.cpp
+ * @author Zawarudo (@zawarudo)
+ * @version 1.0
+ * @date 2026-10-18
+ * @copyright Copyright (c) 2026
+ *
+ * Implementation of the memory mapped key file defined in KeyFile.h.
+ */
+
+// includes.
+#include "KeyFile.h"
+#include <climits>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+/* Destructor. */
+KeyFile::~KeyFile() {
+  if (n > 0)
+    munmap((void *)keys, n * sizeof(int));
+}
+
+/* Open. */
+bool KeyFile::open(const char *path) {
+  if (n > 0)
+    munmap((void *)keys, n * sizeof(int));
+  keys = nullptr;
+  n = 0;
+
+  int fd = ::open(path, O_RDONLY);
+  if (fd < 0)
+    return false;
+  struct stat st;
+  // the trees take an int number of keys, so a larger file is rejected rather than truncated.
+  if (fstat(fd, &st) != 0 || st.st_size % sizeof(int) != 0 || st.st_size / sizeof(int) > (size_t)INT_MAX) {
+    close(fd);
+    return false;
+  }
+  if (st.st_size == 0) {     // an empty key set, nothing to map.
+    close(fd);
+    return true;
+  }
+
+  void *p = mmap(nullptr, st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+  close(fd);     // the mapping keeps the file open.
+  if (p == MAP_FAILED)
+    return false;
+  madvise(p, st.st_size, MADV_SEQUENTIAL);
+  keys = (const int *)p;
+  n = st.st_size / sizeof(int);
+
+  for (size_t i = 1; i < n; i++) {
+    if (keys[i - 1] >= keys[i]) {
+      munmap(p, st.st_size);
+      keys = nullptr;
+      n = 0;
+      return false;
+    }
+  }
+  return true;
+}
@@ -12,8 +12,15 @@
 
 // includes.
 #include "RedBlackTree.h"
+#include <atomic>
 #include <climits>
 #include <iostream>
+#include <thread>
+
+// defines.
+#define PARALLEL_CUTOFF (1 << 16)     // minimum number of keys for the O(n) constructions to use more than one thread.
+
+std::atomic<size_t> spawnCutoff(PARALLEL_CUTOFF);     // the current parallel cutoff, see setParallelCutoff.
 
 /**
  * @brief Defines the nil node. The nil node is a special node that represents the absence of a child in the red-black tree. It is used as a sentinel pointer.
@@ -29,10 +36,13 @@ Node *Node::nil = [] {
   n->minDepth = SHORT_MAX;     // The minimum depth of the nil node is set to the maximum possible value, since it is an external node and has no children.
   n->maxDepth = SHORT_MIN;     // The maximum depth of the nil node is set to the minimum possible value, since it is an external node and has no children.
   n->blackHeight = -1;         // The height of the nil node is set to -1, it's the only node with height -1.
+  n->size = 0;                 // The nil node holds no keys.
 
   return n;     // Return the pointer to the initialized nil node.
 }();     // Initialize the nil node.
 
+const AuxiliaryTree RedBlackAuxiliary = {join, split, deleteMin, deleteMax};
+
 /* Headers of auxiliary functions. */
 
 Node *balance(Node *h);
@@ -41,6 +51,7 @@ Node *rotateRight(Node *h);
 Node *moveRedLeft(Node *h);
 Node *moveRedRight(Node *h);
 std::pair<Node *, Node *> detach(Node *h);
+void blacken(Node *h);
 
 /* NewNode. */
 
@@ -53,6 +64,24 @@ Node *newNode(int key, int depth) {
   return x;
 }
 
+/* NewMapNode. */
+
+Node *newMapNode(int key, long long value, const Monoid *monoid, int depth) {
+  Node *x = new MapNode(key, value, monoid);
+  x->left = x->right = Node::nil;
+  x->depth = x->minDepth = x->maxDepth = depth;
+  return x;
+}
+
+/* DeleteNode. */
+
+void deleteNode(Node *x) {
+  if (x->hasValue)
+    delete static_cast<MapNode *>(x);
+  else
+    delete x;
+}
+
 /* Search */
 
 /**
@@ -74,6 +103,52 @@ std::pair<Node *, Node *> searchRec(Node *h, int key, Node *p = Node::nil) {
 
 std::pair<Node *, Node *> search(Node *h, int key) { return searchRec(h, key); }
 
+/* Build. */
+
+/**
+ * @brief Recursive build method. Builds the trees of the keys left and right of the middle one, the left one on a new
+ * thread while spawn is positive, and joins them with the middle node.
+ *
+ * @param nodeAt The function returning the node of the key at a given index, ready to be joined.
+ * @param l The left bound of the range of keys.
+ * @param r The right bound of the range of keys.
+ * @param spawn The number of recursion levels that still split the work between two threads.
+ * @return The root of the tree with the keys in [l, r].
+ */
+template <typename NodeAt>
+Node *buildRec(const NodeAt &nodeAt, long l, long r, int spawn) {
+  if (l > r)
+    return Node::nil;
+  long m = l + (r - l) / 2;
+  Node *left = Node::nil, *right = Node::nil;
+  if (spawn > 0) {
+    std::thread worker([&] { left = buildRec(nodeAt, l, m - 1, spawn - 1); });
+    right = buildRec(nodeAt, m + 1, r, spawn - 1);
+    worker.join();
+  } else {
+    left = buildRec(nodeAt, l, m - 1, 0);
+    right = buildRec(nodeAt, m + 1, r, 0);
+  }
+  return join(left, nodeAt(m), right);
+}
+
+Node *build(const int *keys, size_t n) {
+  return buildRec([keys](long m) { return newNode(keys[m]); }, 0, (long)n - 1, spawnLevels(n));
+}
+
+/* Build. */
+
+Node *build(Node *const *nodes, size_t n) {
+  auto nodeAt = [nodes](long m) {
+    Node *x = nodes[m];
+    x->isExternal = false;     // the node may come from a tango tree.
+    x->blackHeight = 0;
+    x->depth = 0;
+    return x;
+  };
+  return buildRec(nodeAt, 0, (long)n - 1, spawnLevels(n));
+}
+
 /* Insert. */
 
 /**
@@ -156,17 +231,18 @@ Node *join(Node *leftTree, Node *x, Node *rightTree) {
 std::tuple<Node *, Node *, Node *> splitRec(Node *h, int key) {
   if (key < h->key) {
     auto [left, x, right] = splitRec(h->left, key);
-    h->right->color = BLACK;     // Ensure the left child of h is black before joining.
+    blacken(h->right);     // Ensure the left child of h is black before joining.
     return {left, x, join(right, h, h->right)};
   }
   if (key > h->key) {
     auto [left, x, right] = splitRec(h->right, key);
-    h->left->color = BLACK;     // Ensure the left child of h is black before joining.
+    blacken(h->left);     // Ensure the left child of h is black before joining.
     return {join(h->left, h, left), x, right};
   }
 
   auto [left, right] = detach(h);
-  left->color = right->color = BLACK;         // Ensure that the left root subtree is black.
+  blacken(left);     // Ensure that the left and right root subtrees are black.
+  blacken(right);
   return {left, h, right};     // Return the left subtree, the node with the given key, and the right subtree as a tuple.
 }
 
@@ -175,6 +251,37 @@ std::tuple<Node *, Node *, Node *> split(Node *h, int key) {
   return {l, x, r};
 }
 
+/* SplitAtRank. */
+
+/**
+ * @brief Recursive split by rank method. It follows splitRec, choosing the side from the size of the left subtree
+ * instead of the keys.
+ *
+ * @param h The subtree to split. Should contain a key with rank i.
+ * @param i The rank of the splitter node in the subtree rooted at h.
+ * @return A tuple containing the left tree, the node with rank i and the right tree after applying the split operation.
+ */
+std::tuple<Node *, Node *, Node *> splitAtRankRec(Node *h, int i) {
+  int here = h->isDeleted ? 0 : 1;     // an erased key takes no rank.
+  if (i < h->left->size) {
+    auto [left, x, right] = splitAtRankRec(h->left, i);
+    blacken(h->right);
+    return {left, x, join(right, h, h->right)};
+  }
+  if (i >= h->left->size + here) {
+    auto [left, x, right] = splitAtRankRec(h->right, i - h->left->size - here);
+    blacken(h->left);
+    return {join(h->left, h, left), x, right};
+  }
+
+  auto [left, right] = detach(h);
+  blacken(left);
+  blacken(right);
+  return {left, h, right};
+}
+
+std::tuple<Node *, Node *, Node *> splitAtRank(Node *h, int i) { return splitAtRankRec(h, i); }
+
 /* DeleteMin */
 
 /**
@@ -200,7 +307,7 @@ std::pair<Node *, Node *> deleteMin(Node *root) {
   if (root->left->color == BLACK)
     root->color = RED;     // ensure that the root or the left children is red before deleting the minimum
   auto [min, h] = deleteMinRec(root);
-  h->color = BLACK;
+  blacken(h);     // the tree may be empty now.
   return {min, h};
 }
 
@@ -232,10 +339,98 @@ std::pair<Node *, Node *> deleteMax(Node *root) {
   if (root->left->color == BLACK)
     root->color = RED;
   auto [max, h] = deleteMaxRec(root);
-  h->color = BLACK;
+  blacken(h);
   return {max, h};
 }
 
+/* PushBack. */
+
+/**
+ * @brief Recursive append method. It follows the right spine down to the bottom, where the new node is attached, and balances the spine on the way back. Once
+ * a level absorbs the new node, balance finds no red link to fix above it and only updates the node fields.
+ *
+ * @param h The subtree root.
+ * @param key The key to append, greater than every key in the subtree.
+ * @return The new root of the subtree.
+ */
+Node *pushBackRec(Node *h, int key) {
+  if (h->isExternal)
+    return newNode(key);
+  h->right = pushBackRec(h->right, key);
+  return balance(h);
+}
+
+Node *pushBack(Node *root, int key) {
+  root = pushBackRec(root, key);
+  root->color = BLACK;
+  return root;
+}
+
+/* PopFront. */
+
+/**
+ * @brief Fixes the given node after its left subtree lost one black node. In 2-3 tree terms, the short child borrows a key from its right sibling when the
+ * sibling is a 3-node, and is merged with it otherwise, which moves the shortage one level up when h is black.
+ *
+ * @param h The node whose left subtree is short. Its right child is black, as every right child of a left-leaning tree.
+ * @return The new root of the subtree and whether the subtree is still short of one black node.
+ */
+std::pair<Node *, bool> fixShortLeft(Node *h) {
+  Node *s = h->right;
+  if (h->left->color == RED) {     // a red root makes up for the missing black node.
+    h->left->color = BLACK;
+    update(h);
+    return {h, false};
+  }
+  if (s->left->color == RED) {     // borrow from the 3-node sibling: its red key moves up, h moves down to the short side.
+    Node *x = s->left;
+    h->right = x->left;
+    s->left = x->right;
+    x->left = h;
+    x->right = s;
+    x->color = h->color;
+    h->color = BLACK;
+    update(h);
+    update(s);
+    update(x);
+    return {x, false};
+  }
+  bool isShort = h->color == BLACK;     // merge with the 2-node sibling into the 3-node s, red h leaning left.
+  h->right = s->left;
+  s->left = h;
+  h->color = RED;
+  update(h);
+  update(s);
+  return {s, isShort};
+}
+
+/**
+ * @brief Recursive method to remove the min node of the given subtree, bottom-up. The min node of a left-leaning tree has no children, so it is replaced by nil
+ * and only a black one leaves its parent short.
+ *
+ * @param h The subtree root. Should not be nil.
+ * @return The min node, the new root of the subtree and whether the subtree is short of one black node.
+ */
+std::tuple<Node *, Node *, bool> popFrontRec(Node *h) {
+  if (h->left->isExternal)
+    return {h, h->right, h->color == BLACK};
+  auto [min, x, isShort] = popFrontRec(h->left);
+  h->left = x;
+  if (!isShort) {
+    update(h);     // the shortage was absorbed below, only the sizes change.
+    return {min, h, false};
+  }
+  auto [y, stillShort] = fixShortLeft(h);
+  return {min, y, stillShort};
+}
+
+std::pair<Node *, Node *> popFront(Node *root) {
+  auto [min, h, isShort] = popFrontRec(root);
+  blacken(h);     // a short root just lowers the black height of the tree.
+  detach(min);
+  return {min, h};
+}
+
 /* Min. */
 
 Node *min(Node *root) {
@@ -254,21 +449,118 @@ Node *max(Node *root) {
   return root;
 }
 
+/* Rank. */
+
+int rank(Node *root, int key) {
+  int r = 0;
+  while (root != Node::nil && root->key != key) {
+    if (key < root->key) {
+      root = root->left;
+    } else {
+      r += root->left->size + (root->isDeleted ? 0 : 1);     // the left subtree and the node are smaller than the key.
+      root = root->right;
+    }
+  }
+  return r + root->left->size;
+}
+
+/* Select. */
+
+Node *select(Node *root, int i) {
+  while (root != Node::nil) {
+    int here = root->isDeleted ? 0 : 1;
+    if (i < root->left->size) {
+      root = root->left;
+    } else if (i < root->left->size + here) {
+      return root;
+    } else {
+      i -= root->left->size + here;
+      root = root->right;
+    }
+  }
+  return Node::nil;
+}
+
+/* Aggregate. */
+
+/**
+ * @brief Returns the value aggregate of the given map node subtree, or the identity for a subtree without live keys.
+ *
+ * @param h The subtree root.
+ * @param m The tree monoid.
+ * @return The subtree aggregate.
+ */
+long long aggOf(Node *h, const Monoid &m) { return h->size > 0 ? static_cast<MapNode *>(h)->agg : m.identity; }
+
+/**
+ * @brief Returns the value of the given map node, or the identity for an erased key.
+ *
+ * @param h The node.
+ * @param m The tree monoid.
+ * @return The node value.
+ */
+long long valueOf(Node *h, const Monoid &m) { return h->isDeleted ? m.identity : static_cast<MapNode *>(h)->value; }
+
+/**
+ * @brief Recursive method to aggregate the values with keys at least lo in the given subtree.
+ *
+ * @param h The subtree root.
+ * @param lo The lower bound of the key range.
+ * @param m The tree monoid.
+ * @return The aggregate of the subtree keys in [lo, +inf).
+ */
+long long suffixRec(Node *h, int lo, const Monoid &m) {
+  if (h == Node::nil)
+    return m.identity;
+  if (h->key < lo)
+    return suffixRec(h->right, lo, m);
+  return m.combine(m.combine(suffixRec(h->left, lo, m), valueOf(h, m)), aggOf(h->right, m));
+}
+
+/**
+ * @brief Recursive method to aggregate the values with keys at most hi in the given subtree.
+ *
+ * @param h The subtree root.
+ * @param hi The upper bound of the key range.
+ * @param m The tree monoid.
+ * @return The aggregate of the subtree keys in (-inf, hi].
+ */
+long long prefixRec(Node *h, int hi, const Monoid &m) {
+  if (h == Node::nil)
+    return m.identity;
+  if (h->key > hi)
+    return prefixRec(h->left, hi, m);
+  return m.combine(aggOf(h->left, m), m.combine(valueOf(h, m), prefixRec(h->right, hi, m)));
+}
+
+long long aggregate(Node *root, int lo, int hi, const Monoid &monoid) {
+  while (root != Node::nil && (root->key < lo || root->key > hi))
+    root = root->key < lo ? root->right : root->left;     // descend to the first node inside the range.
+  if (root == Node::nil)
+    return monoid.identity;
+  long long left = suffixRec(root->left, lo, monoid);
+  long long right = prefixRec(root->right, hi, monoid);
+  return monoid.combine(monoid.combine(left, valueOf(root, monoid)), right);
+}
+
 /* Print. */
 
-void printRec(Node *root, int indent, int step) {
+void printRec(Node *root, int indent, int step, std::ostream &out) {
   if (root != Node::nil) {
-    printRec(root->right, indent + step, step);
-    std::cout << std::string(indent, ' ') << '(' << root->key << ')' << "\n";
-    printRec(root->left, indent + step, step);
+    printRec(root->right, indent + step, step, out);
+    out << std::string(indent, ' ') << '(' << root->key << ')' << "\n";
+    printRec(root->left, indent + step, step, out);
   }
 }
 
-void print(Node *root) { return printRec(root, 0, 4); }
+void print(Node *root) { return printRec(root, 0, 4, std::cout); }
+
+void print(Node *root, std::ostream &out) { return printRec(root, 0, 4, out); }
 
 /* Update. */
 
 void update(Node *h) {
+  augment(h);
 
   if (h->isExternal) {
     h->blackHeight = -1;
@@ -281,6 +573,38 @@ void update(Node *h) {
   }
 }
 
+/* SpawnLevels. */
+
+int spawnLevels(size_t n) {
+  if (n < spawnCutoff.load(std::memory_order_relaxed))
+    return 0;
+  int levels = 0;
+  for (unsigned threads = std::thread::hardware_concurrency(); threads > 1; threads >>= 1)
+    levels++;
+  return levels;
+}
+
+/* SetParallelCutoff. */
+
+void setParallelCutoff(size_t n) { spawnCutoff.store(n > 0 ? n : PARALLEL_CUTOFF, std::memory_order_relaxed); }
+
+/* ParallelCutoff. */
+
+size_t parallelCutoff() { return spawnCutoff.load(std::memory_order_relaxed); }
+
+/* Augment. */
+
+void augment(Node *h) {
+  if (h == Node::nil)
+    return;
+  h->size = h->left->size + h->right->size + (h->isDeleted ? 0 : 1);
+  if (h->hasValue) {
+    MapNode *x = static_cast<MapNode *>(h);
+    const Monoid &m = *x->monoid;
+    x->agg = m.combine(m.combine(aggOf(h->left, m), valueOf(h, m)), aggOf(h->right, m));
+  }
+}
+
 /* Auxiliary functions definitions. */
 
 /**
@@ -403,4 +727,16 @@ std::pair<Node *, Node *> detach(Node *h) {
   h->left = h->right = Node::nil;         // Detach the left and right subtrees from h by setting them to nil.
   h->color = BLACK;                       // Set h's color to BLACK.
   return {leftSubtree, rightSubtree};     // Return the detached left and right subtrees as a pair.
+}
+
+/**
+ * @brief Colors the given node black. The shared nil node is black already and is never written, so that independent
+ * trees can be changed from different threads.
+ *
+ * @param h The node.
+ * @note Time Complexity: O(1)
+ */
+void blacken(Node *h) {
+  if (h != Node::nil)
+    h->color = BLACK;
 }
\ No newline at end of file
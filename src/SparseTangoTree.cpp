@@ -0,0 +1,128 @@
+/**
+ * @file SparseTangoTree.cpp
+ * @author Zawarudo (@zawarudo)
+ * @version 1.0
+ * @date 2026-10-18
+ * @copyright Copyright (c) 2026
+ *
+ * Implementation of the rank map and the sparse key front-end defined in SparseTangoTree.h.
+ */
+
+// includes. //
+#include "SparseTangoTree.h"
+#include <algorithm>
+#include <stdexcept>
+
+// defines. //
+#define BUCKET_LOAD 4     // average number of keys per bucket of the perfect hash.
+
+/* Auxiliary functions. */
+
+/**
+ * @brief Mixes the bits of the given value into a 64-bit hash (the splitmix64 finalizer).
+ *
+ * @param x The value.
+ * @return The value hash.
+ */
+uint64_t mix64(uint64_t x) {
+  x += 0x9E3779B97F4A7C15ull;
+  x = (x ^ (x >> 30)) * 0xBF58476D1CE4E5B9ull;
+  x = (x ^ (x >> 27)) * 0x94D049BB133111EBull;
+  return x ^ (x >> 31);
+}
+
+/**
+ * @brief Maps a 64-bit hash uniformly onto [0, n) with a multiplication instead of a division.
+ *
+ * @param h The hash.
+ * @param n The range size.
+ * @return The position in [0, n).
+ */
+size_t reduce(uint64_t h, size_t n) {
+#if defined(__GNUC__)
+  return (size_t)(((unsigned __int128)h * n) >> 64);
+#else
+  // the high half of the 128-bit product, from the four 32-bit partial products.
+  uint64_t m = n, hl = h & 0xFFFFFFFFull, hh = h >> 32, ml = m & 0xFFFFFFFFull, mh = m >> 32;
+  uint64_t low = hl * ml, cross1 = hh * ml, cross2 = hl * mh;
+  uint64_t middle = (low >> 32) + (cross1 & 0xFFFFFFFFull) + (cross2 & 0xFFFFFFFFull);
+  return (size_t)(hh * mh + (cross1 >> 32) + (cross2 >> 32) + (middle >> 32));
+#endif
+}
+
+/**
+ * @brief Returns the slot of a key hash under the given bucket displacement.
+ *
+ * @param h The key hash.
+ * @param d The displacement.
+ * @param n The number of slots.
+ * @return The slot in [0, n).
+ */
+size_t displace(uint64_t h, uint32_t d, size_t n) { return reduce(mix64(h ^ (d * 0xD6E8FEB86659FD93ull)), n); }
+
+/* RankMap. */
+
+RankMap::RankMap(std::vector<uint64_t> k) : keys(std::move(k)) {
+  std::sort(keys.begin(), keys.end());
+  keys.erase(std::unique(keys.begin(), keys.end()), keys.end());
+  size_t n = keys.size();
+  size_t b = std::max<size_t>(n / BUCKET_LOAD, 1);
+  displacements.assign(b, 0);
+  ranks.assign(n, 0);
+
+  // group the keys (by rank) in buckets, and place the buckets from the largest to the smallest.
+  std::vector<std::vector<int>> buckets(b);
+  for (size_t i = 0; i < n; i++)
+    buckets[reduce(mix64(keys[i]), b)].push_back(i);
+  std::vector<size_t> order(b);
+  for (size_t i = 0; i < b; i++)
+    order[i] = i;
+  std::stable_sort(order.begin(), order.end(), [&](size_t x, size_t y) { return buckets[x].size() > buckets[y].size(); });
+
+  std::vector<bool> taken(n, false);
+  std::vector<size_t> slots;
+  for (size_t j : order) {
+    if (buckets[j].empty())
+      break;
+    for (uint32_t d = 0;; d++) {
+      if (d == UINT32_MAX)
+        throw std::runtime_error("RankMap: no displacement found for a bucket");
+      slots.clear();
+      for (int i : buckets[j]) {
+        size_t s = displace(mix64(keys[i]), d, n);
+        if (taken[s] || std::find(slots.begin(), slots.end(), s) != slots.end())
+          break;
+        slots.push_back(s);
+      }
+      if (slots.size() == buckets[j].size()) {     // every key of the bucket has a free slot.
+        displacements[j] = d;
+        for (size_t t = 0; t < slots.size(); t++) {
+          taken[slots[t]] = true;
+          ranks[slots[t]] = buckets[j][t] + 1;
+        }
+        break;
+      }
+    }
+  }
+}
+
+size_t RankMap::slot(uint64_t key) const {
+  uint64_t h = mix64(key);
+  return displace(h, displacements[reduce(h, displacements.size())], keys.size());
+}
+
+int RankMap::rank(uint64_t key) const {
+  if (keys.empty())
+    return 0;
+  int r = ranks[slot(key)];
+  return keys[r - 1] == key ? r : 0;     // a key outside the set lands on the slot of some other key.
+}
+
+/* SparseTangoTree. */
+
+SparseTangoTree::SparseTangoTree(const std::vector<uint64_t> &keys) : map(keys), tree(map.size()) {}
+
+bool SparseTangoTree::contains(uint64_t key) {
+  int r = map.rank(key);
+  return r != 0 && tree.contains(r);
+}
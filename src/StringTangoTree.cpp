@@ -0,0 +1,96 @@
+/**
+ * @file StringTangoTree.cpp
+ * @author Zawarudo (@zawarudo)
+ * @version 1.0
+ * @date 2026-10-18
+ * @copyright Copyright (c) 2026
+ *
+ * Implementation of the string key front-end defined in StringTangoTree.h.
+ */
+
+// includes.
+#include "StringTangoTree.h"
+#include <algorithm>
+
+// The aggregate of the prefixes is never read, the monoid only makes the nodes map nodes, whose value holds the prefix.
+const Monoid PrefixMonoid = {0, [](long long a, long long b) { return a | b; }};
+
+/* Auxiliary functions. */
+
+uint64_t normalizedPrefix(const std::string &s, size_t offset) {
+  uint64_t p = 0;
+  size_t m = s.size() > offset ? std::min<size_t>(s.size() - offset, 8) : 0;
+  for (size_t i = 0; i < m; i++)
+    p |= (uint64_t)(unsigned char)s[offset + i] << (56 - 8 * i);
+  return p;
+}
+
+/**
+ * @brief Sorts and deduplicates the given keys.
+ *
+ * @param keys The keys.
+ * @return The sorted keys, without duplicates.
+ */
+std::vector<std::string> sortedKeys(std::vector<std::string> keys) {
+  std::sort(keys.begin(), keys.end());
+  keys.erase(std::unique(keys.begin(), keys.end()), keys.end());
+  return keys;
+}
+
+/**
+ * @brief Returns the leading bytes shared by all the given keys.
+ *
+ * @param sorted The keys, sorted.
+ * @return The common leading bytes.
+ */
+std::string sharedPrefix(const std::vector<std::string> &sorted) {
+  if (sorted.empty())
+    return std::string();
+  const std::string &first = sorted.front(), &last = sorted.back();     // they share the bytes every key shares.
+  size_t d = std::mismatch(first.begin(), first.begin() + std::min(first.size(), last.size()), last.begin()).first - first.begin();
+  return first.substr(0, d);
+}
+
+/**
+ * @brief Creates the nodes of the given keys: map nodes with the key rank as the key and the key prefix as the value.
+ *
+ * @param sorted The keys, sorted.
+ * @param offset The number of leading bytes the prefixes skip.
+ * @return The nodes, in the key order.
+ */
+std::vector<Node *> prefixNodes(const std::vector<std::string> &sorted, size_t offset) {
+  std::vector<Node *> nodes;
+  nodes.reserve(sorted.size());
+  for (size_t i = 0; i < sorted.size(); i++)
+    nodes.push_back(newMapNode(i + 1, (long long)normalizedPrefix(sorted[i], offset), &PrefixMonoid));
+  return nodes;
+}
+
+/* StringTangoTree. */
+
+StringTangoTree::StringTangoTree(std::vector<std::string> k) : StringTangoTree(sortedKeys(std::move(k)), 0) {}
+
+StringTangoTree::StringTangoTree(std::vector<std::string> &&sorted, int)
+    : TangoTree(prefixNodes(sorted, sharedPrefix(sorted).size()), &PrefixMonoid), common(sharedPrefix(sorted)), keys(std::move(sorted)) {}
+
+int StringTangoTree::rank(const std::string &key) const {
+  if (key.compare(0, common.size(), common) != 0)
+    return 0;     // every key starts with the common bytes.
+  uint64_t p = normalizedPrefix(key, common.size());
+  for (Node *h = root; h != Node::nil;) {     // the same search as the tree's, through the auxiliary trees.
+    uint64_t q = static_cast<MapNode *>(h)->value;
+    int c = p < q ? -1 : p > q ? 1 : key.compare(keys[h->key - 1]);     // the characters are read on a prefix tie only.
+    if (c == 0)
+      return h->key;
+    h = c < 0 ? h->left : h->right;
+  }
+  return 0;
+}
+
+bool StringTangoTree::contains(const std::string &key) {
+  int r = rank(key);
+  if (r == 0)
+    return false;
+  access(r);     // the key path becomes the root preferred path, near the top of the next searches.
+  return true;
+}
@@ -0,0 +1,70 @@
+/**
+ * @file TangoMap.cpp
+ * @author Zawarudo (@zawarudo)
+ * @version 1.0
+ * @date 2026-10-18
+ * @copyright Copyright (c) 2026
+ *
+ * Implementation of the Tango Tree map defined in TangoMap.h.
+ */
+
+// includes.
+#include "TangoMap.h"
+#include <algorithm>
+#include <climits>
+
+/* Monoids. */
+
+const Monoid SumMonoid = {0, [](long long a, long long b) { return a + b; }};
+const Monoid MinMonoid = {LLONG_MAX, [](long long a, long long b) { return std::min(a, b); }};
+const Monoid MaxMonoid = {LLONG_MIN, [](long long a, long long b) { return std::max(a, b); }};
+
+/* Auxiliary functions. */
+
+/**
+ * @brief Creates the map nodes of the given entries.
+ *
+ * @param entries The (key, value) entries.
+ * @param monoid The value monoid.
+ * @return The nodes, in the entries order.
+ */
+std::vector<Node *> mapNodes(const std::vector<std::pair<int, long long>> &entries, const Monoid *monoid) {
+  std::vector<Node *> nodes;
+  nodes.reserve(entries.size());
+  for (const auto &[key, value] : entries)
+    nodes.push_back(newMapNode(key, value, monoid));
+  return nodes;
+}
+
+/* Constructor. */
+TangoMap::TangoMap(const Monoid &monoid) : TangoTree(std::vector<Node *>(), &monoid) {}
+
+/* Constructor. */
+TangoMap::TangoMap(const std::vector<std::pair<int, long long>> &entries, const Monoid &monoid) : TangoTree(mapNodes(entries, &monoid), &monoid) {}
+
+/* Put. */
+bool TangoMap::put(int key, long long value) {
+  bool inserted = insert(key);
+  MapNode *x = static_cast<MapNode *>(access(key));     // the key is now in the root preferred path.
+  x->value = value;
+  refresh(key);
+  return inserted;
+}
+
+/* Get. */
+bool TangoMap::get(int key, long long &value) {
+  Node *x = access(key);
+  if (x == Node::nil || x->isDeleted)
+    return false;
+  value = static_cast<MapNode *>(x)->value;
+  return true;
+}
+
+/* Aggregate. */
+long long TangoMap::aggregate(int lo, int hi) {
+  if (lo > hi)
+    return monoid->identity;
+  access(lo);
+  access(hi);
+  return ::aggregate(root, lo, hi, *monoid);
+}
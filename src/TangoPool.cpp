@@ -0,0 +1,141 @@
+/**
+ * @file TangoPool.cpp
+ * @author Zawarudo (@zawarudo)
+ * @version 1.0
+ * @date 2026-10-18
+ * @copyright Copyright (c) 2026
+ *
+ * Implementation of the Tango Tree pool defined in TangoPool.h.
+ */
+
+// includes.
+#include "TangoPool.h"
+#include <algorithm>
+#include <new>
+
+// defines.
+#define SLAB_BYTES (1 << 16)     // default minimum size of the memory chunk carved into the blocks of a size class.
+
+/* Auxiliary functions. */
+
+/**
+ * @brief Returns the size class of a block of n nodes. Up to 16 nodes every size has its own class; above, each power of
+ * two range is split into 8 classes, so a block is at most 1/8 larger than needed.
+ *
+ * @param n The number of nodes, at least 1.
+ * @return The size class.
+ */
+int classOf(int n) {
+  if (n <= 16)
+    return n;
+  // 2^b < n <= 2^(b + 1).
+#if defined(__GNUC__)
+  int b = 31 - __builtin_clz(n - 1);
+#else
+  int b = 0;
+  while ((n - 1) >> (b + 1))
+    b++;
+#endif
+  int step = 1 << (b - 3);
+  return 17 + 8 * (b - 4) + (n + step - 1) / step - 9;
+}
+
+/**
+ * @brief Returns the number of nodes of a block of the given size class.
+ *
+ * @param c The size class.
+ * @return The block capacity.
+ */
+int capacityOf(int c) {
+  if (c <= 16)
+    return c;
+  int b = 4 + (c - 17) / 8;
+  return (9 + (c - 17) % 8) << (b - 3);
+}
+
+/* Constructor. */
+TangoPool::TangoPool() : live(0) {
+  size_t bytes = TangoTree::defaultConfig().slabBytes;
+  slabBytes = bytes > 0 ? bytes : SLAB_BYTES;
+}
+
+/* Allocate. */
+Node *TangoPool::allocate(int n) {
+  int c = classOf(n);
+  if ((int)classes.size() <= c)
+    classes.resize(c + 1);
+  SizeClass &sc = classes[c];
+  if (!sc.free.empty()) {
+    Node *block = sc.free.back();
+    sc.free.pop_back();
+    return block;
+  }
+  if (sc.left == 0) {
+    size_t blockBytes = capacityOf(c) * sizeof(Node);
+    sc.left = std::max<size_t>(slabBytes / blockBytes, 1);
+    sc.next = (Node *)::operator new(sc.left * blockBytes);
+    slabs.push_back(sc.next);
+  }
+  sc.left--;
+  Node *block = sc.next;
+  sc.next += capacityOf(c);
+  return block;
+}
+
+/* Create. */
+int TangoPool::create(const int *keys, int n) {
+  Node *block = n > 0 ? allocate(n) : nullptr;
+  Tree tree = {n > 0 ? buildTangoInPlace(block, keys, n) : Node::nil, block, n};
+
+  live++;
+  if (!freeIds.empty()) {
+    int id = freeIds.back();
+    freeIds.pop_back();
+    trees[id] = tree;
+    return id;
+  }
+  trees.push_back(tree);
+  return trees.size() - 1;
+}
+
+/* CreateBulk. */
+std::vector<int> TangoPool::createBulk(const std::vector<std::vector<int>> &keySets) {
+  trees.reserve(trees.size() + keySets.size());
+  std::vector<int> ids;
+  ids.reserve(keySets.size());
+  for (const std::vector<int> &keys : keySets)
+    ids.push_back(create(keys.data(), keys.size()));
+  return ids;
+}
+
+/* Destroy. */
+void TangoPool::destroy(int id) {
+  Tree &tree = trees[id];
+  if (tree.size < 0)     // a free id, already destroyed.
+    return;
+  if (tree.block != nullptr)
+    classes[classOf(tree.size)].free.push_back(tree.block);     // nodes are trivially destructible.
+  tree = {Node::nil, nullptr, -1};
+  freeIds.push_back(id);
+  live--;
+}
+
+/* DestroyBulk. */
+void TangoPool::destroyBulk(const std::vector<int> &ids) {
+  for (int id : ids)
+    destroy(id);
+}
+
+/* Clear. */
+void TangoPool::clear() {
+  for (void *slab : slabs)
+    ::operator delete(slab);
+  slabs.clear();
+  classes.clear();
+  trees.clear();
+  freeIds.clear();
+  live = 0;
+}
+
+/* Contains. */
+bool TangoPool::contains(int id, int key) { return accessTango(trees[id].root, key) != Node::nil; }
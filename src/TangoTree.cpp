@@ -19,8 +19,21 @@
 // includes.
 #include "TangoTree.h"
 #include "RedBlackTree.h"
+#include "BiasedTree.h"
+#include <algorithm>
 #include <cassert>
+#include <climits>
+#include <cstdlib>
+#include <fstream>
 #include <iostream>
+#include <memory>
+#include <new>
+#include <sstream>
+#include <thread>
+
+// defines.
+#define FINGER_LEVELS 3     // reference levels above a finger of the subtree it searches.
+#define FINGER_STEPS 16     // longest search from a finger subtree before falling back to an access from the root.
 
 void showRec(Node *root, int indent = 0);
 
@@ -47,48 +60,750 @@ Node *buildTango(int l, int r, int depth = 0) {
   Node *middle = newNode(m, depth);
   middle->left = left;
   middle->right = right;
+  augment(middle);
+  middle->depth = middle->minDepth = middle->maxDepth = depth;
+  middle->isExternal = true;
+  middle->blackHeight = -1;
+  return middle;
+}
+
+/**
+ * @brief Parallel version of buildTango over an arbitrary sorted key set: builds the Tango Tree of the keys in the range
+ * [l, r] of the given array. While spawn is positive, the left half is built on a new thread.
+ *
+ * @param keys The keys, sorted in increasing order.
+ * @param l The left bound of the range of keys.
+ * @param r The right bound of the range of keys.
+ * @param depth The current depth in the reference tree.
+ * @param spawn The number of recursion levels that still split the work between two threads.
+ * @return A pointer to the root of the constructed Tango Tree.
+ */
+Node *buildTango(const int *keys, int l, int r, int depth, int spawn) {
+  if (l > r)
+    return Node::nil;
+  int m = l + (r - l) / 2;
+  Node *left = Node::nil, *right = Node::nil;
+  if (spawn > 0) {
+    std::thread worker([&] { left = buildTango(keys, l, m - 1, depth + 1, spawn - 1); });
+    right = buildTango(keys, m + 1, r, depth + 1, spawn - 1);
+    worker.join();
+  } else {
+    left = buildTango(keys, l, m - 1, depth + 1, 0);
+    right = buildTango(keys, m + 1, r, depth + 1, 0);
+  }
+  Node *middle = newNode(keys[m], depth);
+  middle->left = left;
+  middle->right = right;
+  augment(middle);
+  middle->isExternal = true;
+  middle->blackHeight = -1;
+  middle->color = BLACK;
+  return middle;
+}
+
+/**
+ * @brief Returns the number of keys in the subtree of the Eytzinger layout position k, in a layout of m keys.
+ *
+ * @param k The subtree root position (1-indexed).
+ * @param m The number of keys in the layout.
+ * @return The subtree size.
+ * @note Time Complexity: O(log(m)).
+ */
+size_t layoutSize(size_t k, size_t m) {
+  size_t size = 0;
+  for (size_t lo = k, hi = k; lo <= m; lo = 2 * lo, hi = 2 * hi + 1)
+    size += std::min(hi, m) - lo + 1;
+  return size;
+}
+
+/**
+ * @brief Copies keys between a sorted array and the subtree of position k of an Eytzinger layout, walking the subtree
+ * in order.
+ *
+ * @param sorted The sorted keys.
+ * @param layout The Eytzinger layout (1-indexed).
+ * @param m The number of keys.
+ * @param k The subtree root position.
+ * @param i The index, in the sorted array, of the next key in order. It is advanced past the subtree.
+ * @param toLayout true to copy from the sorted array to the layout, false for the other way around.
+ */
+void mapLayout(int *sorted, int *layout, size_t m, size_t k, size_t &i, bool toLayout) {
+  if (k > m)
+    return;
+  mapLayout(sorted, layout, m, 2 * k, i, toLayout);
+  if (toLayout)
+    layout[k] = sorted[i++];
+  else
+    sorted[i++] = layout[k];
+  mapLayout(sorted, layout, m, 2 * k + 1, i, toLayout);
+}
+
+/**
+ * @brief Parallel version of mapLayout. While spawn is positive, the left subtree is copied on a new thread, starting
+ * at the sorted index given by the subtree sizes.
+ *
+ * @param sorted The sorted keys.
+ * @param layout The Eytzinger layout (1-indexed).
+ * @param m The number of keys.
+ * @param k The subtree root position.
+ * @param l The index, in the sorted array, of the first key of the subtree.
+ * @param toLayout true to copy from the sorted array to the layout, false for the other way around.
+ * @param spawn The number of recursion levels that still split the work between two threads.
+ */
+void mapLayoutParallel(int *sorted, int *layout, size_t m, size_t k, size_t l, bool toLayout, int spawn) {
+  if (spawn == 0 || k > m) {
+    mapLayout(sorted, layout, m, k, l, toLayout);
+    return;
+  }
+  size_t i = l + layoutSize(2 * k, m);     // the sorted index of the subtree root.
+  std::thread worker(mapLayoutParallel, sorted, layout, m, 2 * k, l, toLayout, spawn - 1);
+  if (toLayout)
+    layout[k] = sorted[i];
+  else
+    sorted[i] = layout[k];
+  mapLayoutParallel(sorted, layout, m, 2 * k + 1, i + 1, toLayout, spawn - 1);
+  worker.join();
+}
+
+/**
+ * @brief Struct to represent a compressed external subtree (a cold stub). The stub takes the place of the subtree root,
+ * with its key and size, and encodes the subtree in a byte string, in reference preorder. Each node is a varint of its
+ * key gap to the lower bound of its subtree, followed by its tombstone flag and whether it has a left and a right child.
+ * The left subtree follows with its size and byte length, then the right subtree with its size. The byte lengths let a
+ * search split a stub into its root and two smaller stubs without reading the subtrees, and the stubs split from one
+ * code share it. The reference depths are implicit in the shape.
+ */
+struct ColdNode : Node {
+  std::shared_ptr<const std::vector<unsigned char>> code;     // The encoded subtree, shared by the stubs split from it.
+  size_t offset;                                             // The position of the stub root in the code.
+  long long low;                                             // The lower bound of the stub keys, exclusive.
+
+  // Constructor.
+  ColdNode(int k) : Node(k), offset(0), low(0) { isCold = true; }
+};
+
+/**
+ * @brief Appends the given value to the given code as a varint, 7 bits per byte from the lowest ones.
+ *
+ * @param code The code.
+ * @param v The value.
+ */
+void putVarint(std::vector<unsigned char> &code, unsigned long long v) {
+  for (; v >= 0x80; v >>= 7)
+    code.push_back(v | 0x80);
+  code.push_back(v);
+}
+
+/**
+ * @brief Returns the number of bytes of the given value as a varint.
+ *
+ * @param v The value.
+ * @return The number of bytes.
+ */
+size_t varintBytes(unsigned long long v) {
+  size_t bytes = 1;
+  for (; v >= 0x80; v >>= 7)
+    bytes++;
+  return bytes;
+}
+
+/**
+ * @brief Reads a varint written by putVarint.
+ *
+ * @param p The code position. It is advanced past the varint.
+ * @return The value.
+ */
+unsigned long long getVarint(const unsigned char *&p) {
+  unsigned long long v = 0;
+  for (int shift = 0;; shift += 7) {
+    unsigned char b = *p++;
+    v |= (unsigned long long)(b & 0x7f) << shift;
+    if (b < 0x80)
+      return v;
+  }
+}
+
+/**
+ * @brief Returns a cold stub for the subtree encoded at the given code position, with the fields of an external subtree
+ * root.
+ *
+ * @param code The code.
+ * @param offset The position of the subtree root in the code.
+ * @param low The lower bound of the subtree keys, exclusive.
+ * @param size The number of live keys in the subtree.
+ * @param depth The subtree root depth in the reference tree.
+ * @param stamp The access count stamped on the subtree.
+ * @return The cold stub.
+ */
+Node *newStub(const std::shared_ptr<const std::vector<unsigned char>> &code, size_t offset, long long low, int size, int depth, unsigned stamp) {
+  const unsigned char *p = code->data() + offset;
+  ColdNode *stub = new ColdNode(low + (getVarint(p) >> 3));
+  stub->code = code;
+  stub->offset = offset;
+  stub->low = low;
+  stub->left = stub->right = Node::nil;
+  stub->color = BLACK;
+  stub->size = size;
+  stub->blackHeight = -1;
+  stub->depth = stub->minDepth = stub->maxDepth = depth;
+  stub->isExternal = true;
+  stub->stamp = stamp;
+  return stub;
+}
+
+/**
+ * @brief Recursively decodes the subtree encoded at the given code position into new nodes, in the configuration built
+ * by buildTango: every node is a preferred path by itself.
+ *
+ * @param p The code position. It is advanced past the subtree.
+ * @param low The lower bound of the subtree keys, exclusive.
+ * @param depth The subtree root depth in the reference tree.
+ * @return The subtree root.
+ */
+Node *decodeTango(const unsigned char *&p, long long low, int depth) {
+  unsigned long long v = getVarint(p);
+  Node *x = newNode(low + (v >> 3), depth);
+  x->isDeleted = v >> 2 & 1;
+  if (v >> 1 & 1) {
+    getVarint(p);     // the size and byte length, recomputed from the nodes.
+    getVarint(p);
+    x->left = decodeTango(p, low, depth + 1);
+  }
+  if (v & 1) {
+    getVarint(p);
+    x->right = decodeTango(p, x->key, depth + 1);
+  }
+  augment(x);
+  x->isExternal = true;
+  x->blackHeight = -1;
+  x->color = BLACK;
+  return x;
+}
+
+/**
+ * @brief Decodes the given cold stub into new nodes, leaving the stub alone. The subtree comes back in the configuration
+ * built by buildTango, with the reference shape, keys and tombstones it had when it was compressed.
+ *
+ * @param stub The cold stub.
+ * @return The root of the decoded subtree, an external node.
+ * @note Time Complexity: O(n), where n is the number of nodes in the subtree.
+ */
+Node *decodeStub(const Node *stub) {
+  const ColdNode *cold = static_cast<const ColdNode *>(stub);
+  const unsigned char *p = cold->code->data() + cold->offset;
+  Node *h = decodeTango(p, cold->low, stub->depth);
+  h->stamp = stub->stamp;
+  return h;
+}
+
+/**
+ * @brief Expands the root of the given cold stub back into a node, which replaces it in the tree, with its two subtrees
+ * left as smaller stubs sharing the code, and releases the stub (or the tree reference to it, when it is shared with a
+ * fork). A search entering a stub so decodes one node per level it goes down.
+ *
+ * @param stub The cold stub.
+ * @return The expanded node, an external node.
+ * @note Time Complexity: O(1).
+ */
+Node *expandTango(Node *stub) {
+  const ColdNode *cold = static_cast<const ColdNode *>(stub);
+  const unsigned char *base = cold->code->data(), *p = base + cold->offset;
+  unsigned long long v = getVarint(p);
+  Node *x = newNode(stub->key, stub->depth);
+  x->isDeleted = v >> 2 & 1;
+  if (v >> 1 & 1) {
+    int size = getVarint(p);
+    size_t bytes = getVarint(p);
+    x->left = newStub(cold->code, p - base, cold->low, size, stub->depth + 1, stub->stamp);
+    p += bytes;
+  }
+  if (v & 1) {
+    int size = getVarint(p);
+    x->right = newStub(cold->code, p - base, stub->key, size, stub->depth + 1, stub->stamp);
+  }
+  augment(x);
+  x->isExternal = true;
+  x->blackHeight = -1;
+  x->color = BLACK;
+  x->stamp = stub->stamp;
+  if (stub->refs > 1)
+    stub->refs--;
+  else
+    delete cold;
+  return x;
+}
+
+/**
+ * @brief Collects all the nodes of the given Tango Tree (every auxiliary tree, following the external nodes) in key
+ * order. Cold stubs are expanded on the way.
+ *
+ * @param h The root of the tree, not shared with a fork.
+ * @param nodes The vector where the nodes are appended.
+ */
+void flattenTango(Node *&h, std::vector<Node *> &nodes) {
+  if (h == Node::nil)
+    return;
+  if (h->isCold)
+    h = expandTango(h);
+  flattenTango(h->left, nodes);
+  nodes.push_back(h);
+  flattenTango(h->right, nodes);
+}
+
+/**
+ * @brief Collects all the nodes of the given Tango Tree in key order, like flattenTango, without changing the tree: the
+ * cold stubs are decoded into temporary subtrees, left to the caller to release.
+ *
+ * @param h The root of the tree.
+ * @param nodes The vector where the nodes are appended.
+ * @param decoded The vector where the roots of the temporary subtrees are appended.
+ */
+void collectTango(Node *h, std::vector<Node *> &nodes, std::vector<Node *> &decoded) {
+  if (h == Node::nil)
+    return;
+  if (h->isCold) {
+    decoded.push_back(decodeStub(h));
+    collectTango(decoded.back(), nodes, decoded);
+    return;
+  }
+  collectTango(h->left, nodes, decoded);
+  nodes.push_back(h);
+  collectTango(h->right, nodes, decoded);
+}
+
+/**
+ * @brief Returns a copy of the given node, of the same kind (node, map node or cold stub), with no other tree sharing
+ * it.
+ *
+ * @param h The node.
+ * @return The copy.
+ */
+Node *copyNode(const Node *h) {
+  Node *x;
+  if (h->isCold)
+    x = new ColdNode(*static_cast<const ColdNode *>(h));
+  else if (h->hasValue)
+    x = new MapNode(*static_cast<const MapNode *>(h));
+  else
+    x = new Node(*h);
+  x->refs = 1;
+  return x;
+}
+
+/**
+ * @brief Recursively copies the nodes of the auxiliary tree rooted at h. The external subtrees below it are shared by
+ * the copy and the original.
+ *
+ * @param h The subtree root.
+ * @return The root of the copy.
+ */
+Node *copyAuxRec(const Node *h) {
+  Node *x = copyNode(h);
+  for (Node **child : {&x->left, &x->right}) {
+    if (*child == Node::nil)
+      continue;
+    if ((*child)->isExternal)
+      (*child)->refs++;     // a new reference to the external subtree.
+    else
+      *child = copyAuxRec(*child);
+  }
+  return x;
+}
+
+/**
+ * @brief Gives the tree its own copy of the given auxiliary tree, shared with a fork, before it is restructured. Only
+ * the auxiliary tree nodes, O(log(n)) of them, are copied.
+ *
+ * @param h The auxiliary tree root, shared with a fork.
+ * @return The root of the copy, which replaces h in the tree.
+ */
+Node *copyAux(Node *h) {
+  h->refs--;
+  return copyAuxRec(h);
+}
+
+/**
+ * @brief Recursively copies the whole Tango Tree rooted at h, following the external nodes.
+ *
+ * @param h The subtree root.
+ * @return The root of the copy.
+ */
+Node *copyTango(const Node *h) {
+  if (h == Node::nil)
+    return Node::nil;
+  Node *x = copyNode(h);
+  x->left = copyTango(h->left);
+  x->right = copyTango(h->right);
+  return x;
+}
+
+/**
+ * @brief Gives the tree its own copy of every subtree it shares with a fork, so that all its nodes can be relinked.
+ *
+ * @param h The root of the tree.
+ * @return The root of the tree after the copies.
+ */
+Node *ownTango(Node *h) {
+  if (h == Node::nil)
+    return h;
+  if (h->refs > 1) {
+    h->refs--;
+    return copyTango(h);
+  }
+  h->left = ownTango(h->left);
+  h->right = ownTango(h->right);
+  return h;
+}
+
+/**
+ * @brief Releases all the nodes of the given Tango Tree. A subtree shared with a fork only loses a reference.
+ *
+ * @param h The root of the tree.
+ */
+void destroyTango(Node *h) {
+  if (h == Node::nil)
+    return;
+  if (h->refs > 1) {
+    h->refs--;
+    return;
+  }
+  if (h->isCold) {
+    delete static_cast<ColdNode *>(h);
+    return;
+  }
+  destroyTango(h->left);
+  destroyTango(h->right);
+  deleteNode(h);
+}
+
+/**
+ * @brief Links the nodes with indexes in the range [l, r] into the configuration built by buildTango: a balanced
+ * reference tree in which every node is a preferred path by itself. No node is allocated. While spawn is positive, the
+ * left half is linked on a new thread.
+ *
+ * @param nodeAt The function returning the node with a given index, in key order. It is called once per index.
+ * @param l The left bound of the range of nodes.
+ * @param r The right bound of the range of nodes.
+ * @param depth The current depth in the reference tree.
+ * @param spawn The number of recursion levels that still split the work between two threads.
+ * @return A pointer to the root of the linked tree.
+ */
+template <typename NodeAt>
+Node *linkRec(const NodeAt &nodeAt, int l, int r, int depth, int spawn) {
+  if (l > r)
+    return Node::nil;
+  int m = l + (r - l) / 2;
+  Node *middle = nodeAt(m);
+  if (spawn > 0) {
+    std::thread worker([&] { middle->left = linkRec(nodeAt, l, m - 1, depth + 1, spawn - 1); });
+    middle->right = linkRec(nodeAt, m + 1, r, depth + 1, spawn - 1);
+    worker.join();
+  } else {
+    middle->left = linkRec(nodeAt, l, m - 1, depth + 1, 0);
+    middle->right = linkRec(nodeAt, m + 1, r, depth + 1, 0);
+  }
+  augment(middle);
   middle->depth = middle->minDepth = middle->maxDepth = depth;
   middle->isExternal = true;
   middle->blackHeight = -1;
+  middle->color = BLACK;     // an external node is a leaf of its parent auxiliary tree, black as nil.
   return middle;
 }
 
+/**
+ * @brief Links the nodes in the range [l, r] of the given sorted vector into the configuration built by buildTango, see
+ * linkRec.
+ *
+ * @param nodes The nodes, sorted by key.
+ * @param l The left bound of the range of nodes.
+ * @param r The right bound of the range of nodes.
+ * @param depth The current depth in the reference tree.
+ * @param spawn The number of recursion levels that still split the work between two threads.
+ * @return A pointer to the root of the linked tree.
+ */
+Node *linkTango(std::vector<Node *> &nodes, int l, int r, int depth = 0, int spawn = 0) {
+  return linkRec([&nodes](int m) { return nodes[m]; }, l, r, depth, spawn);
+}
+
+/**
+ * @brief Recomputes the subtree sizes and value aggregates along the search path of the given key, after the key was
+ * added, erased, revived or given a new value. The path must lie in the root auxiliary tree, so the external subtrees
+ * hanging from it are unchanged.
+ *
+ * @param h The root of the tree.
+ * @param key The key whose path is updated.
+ */
+void augmentPath(Node *h, int key) {
+  if (h == Node::nil)
+    return;
+  if (key < h->key)
+    augmentPath(h->left, key);
+  else if (key > h->key)
+    augmentPath(h->right, key);
+  augment(h);
+}
+
+/**
+ * @brief Compresses the external subtree rooted at the given node into a cold stub and releases its nodes. The reference
+ * tree of the subtree is the Cartesian tree of its nodes by depth, so a node has a left (right) child exactly when the
+ * node before (after) it in key order is deeper.
+ *
+ * @param h The root of the external subtree.
+ * @param n Set to the number of nodes in the subtree.
+ * @return The cold stub taking the place of h.
+ * @note Time Complexity: O(n).
+ */
+Node *compressTango(Node *h, int &n) {
+  std::vector<Node *> nodes, decoded;
+  collectTango(h, nodes, decoded);
+  n = nodes.size();
+
+  // link the reference tree by indices with the Cartesian tree stack.
+  std::vector<int> left(n, -1), right(n, -1), stack;
+  for (int i = 0; i < n; i++) {
+    while (!stack.empty() && nodes[stack.back()]->depth > nodes[i]->depth) {
+      left[i] = stack.back();
+      stack.pop_back();
+    }
+    if (!stack.empty())
+      right[stack.back()] = i;
+    stack.push_back(i);
+  }
+  int top = stack.front();
+
+  // a subtree is an index range, so the lower bound of its keys is the key before its first node.
+  std::vector<int> order, first(n), live(n);
+  std::vector<bool> isRight(n, false);
+  for (stack.assign(1, top); !stack.empty();) {
+    int i = stack.back();
+    stack.pop_back();
+    order.push_back(i);
+    if (right[i] >= 0) {
+      isRight[right[i]] = true;
+      stack.push_back(right[i]);
+    }
+    if (left[i] >= 0)
+      stack.push_back(left[i]);
+  }
+  auto head = [&](int i) {
+    long long low = first[i] > 0 ? nodes[first[i] - 1]->key : INT_MIN - 1LL;
+    return (unsigned long long)(nodes[i]->key - low) << 3 | nodes[i]->isDeleted << 2 | (left[i] >= 0) << 1 | (right[i] >= 0);
+  };
+
+  // the live sizes and byte lengths of the subtrees, children first, then the code in preorder.
+  std::vector<size_t> bytes(n);
+  for (auto it = order.rbegin(); it != order.rend(); ++it) {
+    int i = *it;
+    first[i] = left[i] >= 0 ? first[left[i]] : i;
+    live[i] = nodes[i]->isDeleted ? 0 : 1;
+    bytes[i] = varintBytes(head(i));
+    if (left[i] >= 0) {
+      live[i] += live[left[i]];
+      bytes[i] += varintBytes(live[left[i]]) + varintBytes(bytes[left[i]]) + bytes[left[i]];
+    }
+    if (right[i] >= 0) {
+      live[i] += live[right[i]];
+      bytes[i] += varintBytes(live[right[i]]) + bytes[right[i]];
+    }
+  }
+  auto code = std::make_shared<std::vector<unsigned char>>();
+  code->reserve(bytes[top]);
+  for (int i : order) {
+    if (isRight[i])
+      putVarint(*code, live[i]);
+    putVarint(*code, head(i));
+    if (left[i] >= 0) {
+      putVarint(*code, live[left[i]]);
+      putVarint(*code, bytes[left[i]]);
+    }
+  }
+  Node *stub = newStub(code, 0, INT_MIN - 1LL, h->size, nodes[top]->depth, h->stamp);
+  destroyTango(h);
+  for (Node *x : decoded)
+    destroyTango(x);
+  return stub;
+}
+
+/**
+ * @brief Compresses every external subtree of the given Tango Tree whose root was last stamped at least age accesses
+ * ago. Subtrees under a recent external root are searched for older ones.
+ *
+ * @param h The root of the subtree. It is replaced by its stub if compressed.
+ * @param epoch The current access count.
+ * @param age The minimum age, in accesses, of the compressed subtrees.
+ * @return The number of nodes compressed.
+ */
+int coolTango(Node *&h, unsigned epoch, unsigned age) {
+  if (h == Node::nil || h->isCold || h->refs > 1)     // a subtree shared with a fork is left alone.
+    return 0;
+  if (h->isExternal && epoch - h->stamp >= age) {
+    int n;
+    h = compressTango(h, n);
+    return n;
+  }
+  return coolTango(h->left, epoch, age) + coolTango(h->right, epoch, age);
+}
+
+/**
+ * @brief Returns the node with the given rank in the given Tango Tree, following the subtree sizes through the
+ * auxiliary trees and expanding the cold stubs on the way.
+ *
+ * @param h The root of the subtree.
+ * @param i The rank, from 0 to the subtree size - 1.
+ * @return The node with rank i.
+ */
+Node *selectTango(Node *&h, int i) {
+  if (h->isCold)
+    h = expandTango(h);
+  else if (h->refs > 1)
+    h = copyAux(h);
+  int here = h->isDeleted ? 0 : 1;
+  if (i < h->left->size)
+    return selectTango(h->left, i);
+  if (i < h->left->size + here)
+    return h;
+  return selectTango(h->right, i - h->left->size - here);
+}
+
+/**
+ * @brief Attaches the given node as the right child of the max node of the given Tango Tree, which is its max node in
+ * the reference tree as well, and updates the subtree fields on the way back. The new node hangs, as a single node
+ * preferred path, in the nil slot right of the max node, whatever auxiliary tree holds it.
+ *
+ * @param h The root of the subtree. Cold stubs and shared auxiliary trees on the right path are expanded or copied.
+ * @param z The new node, an external node with a key greater than every key of the tree.
+ * @return The reference depth given to z.
+ */
+int appendTango(Node *&h, Node *z) {
+  if (h->isCold)
+    h = expandTango(h);
+  else if (h->refs > 1)
+    h = copyAux(h);
+  int depth;
+  if (h->right == Node::nil) {
+    depth = h->depth + 1;
+    z->depth = z->minDepth = z->maxDepth = depth;
+    h->right = z;
+  } else {
+    depth = appendTango(h->right, z);
+  }
+  augment(h);
+  return depth;
+}
+
+/**
+ * @brief Turns the node of the min live key of the given Tango Tree into a tombstone, found following the subtree
+ * sizes as selectTango does, and updates the subtree fields on the way back.
+ *
+ * @param h The root of the subtree, with at least one live key.
+ * @return The node of the erased key.
+ */
+Node *eraseMinTango(Node *&h) {
+  if (h->isCold)
+    h = expandTango(h);
+  else if (h->refs > 1)
+    h = copyAux(h);
+  Node *x = h;
+  if (h->left->size > 0)
+    x = eraseMinTango(h->left);
+  else if (h->isDeleted)
+    x = eraseMinTango(h->right);
+  else
+    h->isDeleted = true;
+  augment(h);
+  return x;
+}
+
+/**
+ * @brief Removes the tombstones from the given nodes and releases them.
+ *
+ * @param nodes The nodes.
+ * @return The number of tombstones removed.
+ */
+int dropTombstones(std::vector<Node *> &nodes) {
+  auto live = std::remove_if(nodes.begin(), nodes.end(), [](Node *x) {
+    if (!x->isDeleted)
+      return false;
+    deleteNode(x);     // drop the tombstone.
+    return true;
+  });
+  int n = nodes.end() - live;
+  nodes.erase(live, nodes.end());
+  return n;
+}
+
+/**
+ * @brief Finds the nil slot where the search of an absent key ends, once the whole reference path to the key is in the
+ * root preferred path, as it is right after the failed access of the key.
+ *
+ * @param root The root of the tree.
+ * @param key The absent key.
+ * @param pred Set to the nearest node on the search path with a smaller key, or nil.
+ * @param succ Set to the nearest node on the search path with a greater key, or nil.
+ * @return The node owning the nil slot, the left one if the key is smaller than its key and the right one otherwise.
+ */
+Node *leafSlot(Node *root, int key, Node *&pred, Node *&succ) {
+  Node *parent = Node::nil;
+  pred = succ = Node::nil;
+  for (Node *h = root; h != Node::nil;) {
+    parent = h;
+    if (key < h->key) {
+      succ = h;
+      h = h->left;
+    } else {
+      pred = h;
+      h = h->right;
+    }
+  }
+  return parent;
+}
+
+/**
+ * @brief Returns the reference depth above which a tree with the given number of nodes is rebuilt, twice the height of
+ * a balanced tree.
+ *
+ * @param n The number of nodes.
+ * @return The depth bound.
+ */
+int depthBound(int n) {
+  int height = 0;
+  while ((n >>= 1) > 0)
+    height++;
+  return 2 * (height + 1);
+}
+
 /**
  * @brief Finds the predecessor key of the given depth in the subtree rooted at h of the min key of the subtree with
- * depth greater than the given depth. If there is no predecessor with the given depth, it returns a default value (-1,
- * in this case) as the predecessor key.
+ * depth greater than the given depth. If there is no predecessor with the given depth, it returns the nil node.
  *
  * @param h The root of the subtree to search for the predecessor.
  * @param depth The depth for which to find the predecessor.
- * @return the predecessor key  of the subtree with depth greater than the given
- * depth.
+ * @return the predecessor node of the subtree with depth greater than the given depth, or nil if there is none.
  */
-int predecessor(Node *h, int depth) {
+Node *predecessor(Node *h, int depth) {
   if (!h->left->isExternal && h->left->maxDepth >= depth)
     return predecessor(h->left, depth);
   if (h->depth >= depth)
-    return h->left->isExternal ? -1 : max(h->left)->key;
-  int p = predecessor(h->right, depth);
-  return p == -1 ? h->key : p;
+    return h->left->isExternal ? Node::nil : max(h->left);
+  Node *p = predecessor(h->right, depth);
+  return p == Node::nil ? h : p;
 }
 
 /**
  * @brief Finds the successor key of the given depth in the subtree rooted at h of the max key of the subtree with
- * depth greater than the given depth. If there is no successor with the given depth, it returns -1 as the successor
- * key.
+ * depth greater than the given depth. If there is no successor with the given depth, it returns the nil node.
  *
  * @param h The root of the subtree to search for the successor.
  * @param depth The depth for which to find the successor.
- * @return The successor key of the subtree with depth greater than the given
- * depth.
+ * @return The successor node of the subtree with depth greater than the given depth, or nil if there is none.
  */
-int successor(Node *h, int depth) {
+Node *successor(Node *h, int depth) {
   if (!h->right->isExternal && h->right->maxDepth >= depth)
     return successor(h->right, depth);
   if (h->depth >= depth)
-    return h->right->isExternal ? -1 : min(h->right)->key;
-  int s = successor(h->left, depth);
-  return s == -1 ? h->key : s;
+    return h->right->isExternal ? Node::nil : min(h->right);
+  Node *s = successor(h->left, depth);
+  return s == Node::nil ? h : s;
 }
 
 /**
@@ -99,11 +814,13 @@ int successor(Node *h, int depth) {
  * @param root The root tree of the Tango Tree.
  * @param depth The min depth, in the reference tree, of the fragment that must be remove from the current root
  * preferred path.
+ * @param stamp The access count stamped on the removed fragment.
+ * @param aux The auxiliary tree operations.
  * @return The new Tango Tree root after removing the keys.
  */
-Node *cut(Node *root, int depth) {
-  int pred = predecessor(root, depth);
-  int succ = successor(root, depth);
+Node *cut(Node *root, int depth, unsigned stamp, const AuxiliaryTree &aux) {
+  Node *pred = predecessor(root, depth);
+  Node *succ = successor(root, depth);
 
   // split the root into tl (< pred) xl (= pred) tm ((> pred, succ <)) xr (= succ) tr (> succ), some ranges, may get a
   // nil node if no key in the tree satisfies the condition.
@@ -112,30 +829,31 @@ Node *cut(Node *root, int depth) {
   Node *xl = Node::nil;
   Node *taux = root;
 
-  if (pred > -1)
-    std::tie(tl, xl, taux) = split(root, pred);
+  if (pred != Node::nil)
+    std::tie(tl, xl, taux) = aux.split(root, pred->key);
 
   Node *tm = taux;
   Node *xr = Node::nil;
   Node *tr = Node::nil;
 
-  if (succ > -1)
-    std::tie(tm, xr, tr) = split(tm, succ);
+  if (succ != Node::nil)
+    std::tie(tm, xr, tr) = aux.split(tm, succ->key);
 
   // joins the tree ensuring that tm is not in the preferred tree anymore.
 
   tm->isExternal = true;
   tm->blackHeight = -1;
+  tm->stamp = stamp;
 
   Node *tt = tm;
 
   if (xl != Node::nil)
-    tt = join(tl, xl, tm);
+    tt = aux.join(tl, xl, tm);
 
   Node *t = tt;
 
   if (xr != Node::nil)
-    t = join(tt, xr, tr);
+    t = aux.join(tt, xr, tr);
 
   return t;
 }
@@ -148,24 +866,25 @@ Node *cut(Node *root, int depth) {
  * @param q The root of the new preferred path tree to be inserted.
  * @param p The last node seen, in the root preferred path tree, before reaching the new preferred path tree to be
  * inserted.
+ * @param aux The auxiliary tree operations.
  * @return The new Tango Tree root after the insertion of the new preferred path tree.
  */
-Node *paste(Node *root, Node *q, Node *p) {
+Node *paste(Node *root, Node *q, Node *p, const AuxiliaryTree &aux) {
   assert(root->maxDepth < q->minDepth);     // Validates the precondition
   q->isExternal = false;
   update(q);     // Update the infos of q, since it is not an external node anymore.
   if (p->left == q) {
-    auto [min, qq] = deleteMin(q);
+    auto [min, qq] = aux.deleteMin(q);
     p->left = min->left;
-    auto [tl, pp, tr] = split(root, p->key);
-    Node *taux = join(qq, pp, tr);
-    root = join(tl, min, taux);
+    auto [tl, pp, tr] = aux.split(root, p->key);
+    Node *taux = aux.join(qq, pp, tr);
+    root = aux.join(tl, min, taux);
   } else {
-    auto [max, qq] = deleteMax(q);
+    auto [max, qq] = aux.deleteMax(q);
     p->right = max->right;
-    auto [tl, pp, tr] = split(root, p->key);
-    Node *taux = join(tl, pp, qq);
-    root = join(taux, max, tr);
+    auto [tl, pp, tr] = aux.split(root, p->key);
+    Node *taux = aux.join(tl, pp, qq);
+    root = aux.join(taux, max, tr);
   }
   return root;
 }
@@ -178,25 +897,92 @@ Node *paste(Node *root, Node *q, Node *p) {
  *
  * @param root The root of the Tango Tree.
  * @param q The root of the new preferred path tree to be inserted in the root preferred path.
+ * @param stamp The access count stamped on the preferred path tree removed from the root preferred path.
+ * @param aux The auxiliary tree operations.
  * @return The new Tango Tree root after performing the Tango operation.
  */
-Node *tango(Node *root, Node *q) {
+Node *tango(Node *root, Node *q, unsigned stamp, const AuxiliaryTree &aux) {
   if (root->maxDepth >= q->minDepth) {
-    root = cut(root, q->minDepth);     // remove all keys that are not in the preferred path anymore.
+    root = cut(root, q->minDepth, stamp, aux);     // remove all keys that are not in the preferred path anymore.
   }
 
-  std::cout << "before paste operation" << std::endl;
-  showRec(root);
-  std::cout << "Performing paste operation" << std::endl;
-
   auto [qq, pp] = search(root, q->key);     // update q and p reference.
-  root = paste(root, qq, pp);               // insert the new keys in the root preferred path.
+  root = paste(root, qq, pp, aux);          // insert the new keys in the root preferred path.
+  return root;
+}
 
-  std::cout << "after paste operation" << std::endl;
-  showRec(root);
+Node *accessTango(Node *&root, int key, unsigned stamp, const AuxiliaryTree &aux) {
+  if (root->refs > 1)     // the root auxiliary tree is shared with a fork.
+    root = copyAux(root);
+  auto [q, p] = search(root, key);
+  while (q->isExternal && q != Node::nil) {     // repeat until success or fail in the search.
+    if (q->isCold)                              // expand a compressed subtree in place.
+      q = (p->left == q ? p->left : p->right) = expandTango(q);
+    else if (q->refs > 1)                       // copy a shared subtree before restructuring it.
+      q = (p->left == q ? p->left : p->right) = copyAux(q);
+    root = tango(root, q, stamp, aux);          // perform a tango operation to updated the root preferred path.
+    std::tie(q, p) = search(root, key);         // update q and p reference for the next iteration.
+  }
+  return q;
+}
+
+Node *buildTangoInPlace(Node *storage, const int *keys, int n) {
+  // the nodes are constructed as they are linked, so no index array is allocated.
+  Node *root = linkRec([storage, keys](int m) { return new (&storage[m]) Node(keys[m]); }, 0, n - 1, 0, 0);
+  if (root != Node::nil) {
+    root->isExternal = false;
+    root->blackHeight = 0;
+  }
   return root;
 }
 
+bool loadConfig(const char *path, TangoConfig &config) {
+  std::ifstream file(path);
+  if (!file)
+    return false;
+  TangoConfig next = config;
+  std::string line;
+  while (std::getline(file, line)) {
+    std::istringstream in(line.substr(0, line.find('#')));
+    std::string name;
+    char equals;
+    long long value;
+    if (!(in >> name))     // a blank or comment line.
+      continue;
+    if (!(in >> equals >> value) || equals != '=' || value < 0 || !(in >> std::ws).eof())
+      return false;
+    if (name == "cacheSets")
+      next.cacheSets = (int)std::min<long long>(value, INT_MAX);
+    else if (name == "filterBits")
+      next.filterBits = (int)std::min<long long>(value, INT_MAX);
+    else if (name == "fingers")
+      next.fingers = (int)std::min<long long>(value, INT_MAX);
+    else if (name == "coldAge")
+      next.coldAge = (unsigned)std::min<long long>(value, UINT_MAX);
+    else if (name == "biased")
+      next.biased = value != 0;
+    else if (name == "parallelCutoff")
+      next.parallelCutoff = (size_t)value;
+    else if (name == "slabBytes")
+      next.slabBytes = (size_t)value;
+  }
+  config = next;
+  return true;
+}
+
+bool saveConfig(const char *path, const TangoConfig &config) {
+  std::ofstream file(path);
+  file << "# Tango Tree configuration, see TangoConfig in TangoTree.h.\n";
+  file << "cacheSets = " << config.cacheSets << '\n';
+  file << "filterBits = " << config.filterBits << '\n';
+  file << "fingers = " << config.fingers << '\n';
+  file << "coldAge = " << config.coldAge << '\n';
+  file << "biased = " << (config.biased ? 1 : 0) << '\n';
+  file << "parallelCutoff = " << config.parallelCutoff << '\n';
+  file << "slabBytes = " << config.slabBytes << '\n';
+  return (bool)file.flush();
+}
+
 /* Debug functions. */
 
 /**
@@ -210,32 +996,851 @@ void showRec(Node *root, int indent) {
     return;
   showRec(root->right, indent + 4);
   std::cout << std::string(indent, ' ');
+  if (root->isCold) {
+    std::cout << '(' << root->key << ",C, " << root->size << ")\n";     // a compressed subtree and its size.
+    return;
+  }
   std::cout << '(' << root->key << ',' << (root->isExternal ? "E" : "I") << ", " << root->blackHeight << ", " << (root->color == RED ? "RED" : "BLACK")
             << ")\n";
   showRec(root->left, indent + 4);
 }
 
+/**
+ * @brief Recursively prints the subtree of position k of a frozen layout, in the same format as showRec.
+ *
+ * @param layout The Eytzinger layout (1-indexed).
+ * @param k The subtree root position.
+ * @param indent The indentation level for formatting.
+ */
+void showLayout(const std::vector<int> &layout, size_t k, int indent = 0) {
+  if (k >= layout.size())
+    return;
+  showLayout(layout, 2 * k + 1, indent + 4);
+  std::cout << std::string(indent, ' ') << '(' << layout[k] << ")\n";
+  showLayout(layout, 2 * k, indent + 4);
+}
+
 /* Tango Tree Operations. */
 
+/**
+ * @brief Checks if the given key is the finger key or one of its neighbours, the keys a finger knows to be in the tree.
+ *
+ * @param f The finger.
+ * @param key The key to check.
+ * @return true if the finger resolves the key, false otherwise.
+ */
+bool covers(const Finger &f, int key) { return f.isSet && (key == f.key || key == f.prev || key == f.next); }
+
+/**
+ * @brief Checks if the given key lies strictly between the finger neighbours, that is, inside the reference subtree
+ * hanging below them. A missing neighbour leaves that side unbounded.
+ *
+ * @param f The finger.
+ * @param key The key to check.
+ * @return true if the key is in the finger neighbourhood, false otherwise.
+ */
+bool near(const Finger &f, int key) { return f.isSet && (f.prev == f.key || f.prev < key) && (f.next == f.key || key < f.next); }
+
+/**
+ * @brief Searches the given key from the top of the finger subtree, through the auxiliary trees and the external
+ * subtrees below it, without restructuring. The subtree in the tree holds every key between the finger bounds.
+ *
+ * @param f The finger, set in the current tree version, with the key between its bounds.
+ * @param key The key to search for.
+ * @return The node of the key, nil if the key is absent, or nullptr if the search hit a cold stub or took too long.
+ */
+Node *searchFinger(const Finger &f, int key) {
+  Node *h = f.node;
+  for (int steps = 0; h != Node::nil; steps++) {
+    if (h->isCold || steps == FINGER_STEPS)     // a stub carries its root key, but not its tombstone flag.
+      return nullptr;
+    if (key == h->key)
+      return h;
+    h = key < h->key ? h->left : h->right;
+  }
+  return h;
+}
+
+/**
+ * @brief Returns the process-wide default configuration, read from the file named by the TANGOTREE_CONFIG environment
+ * variable on the first call. An unreadable file leaves the built-in configuration.
+ *
+ * @return The default configuration.
+ */
+TangoConfig &defaults() {
+  static TangoConfig config = [] {
+    TangoConfig c;
+    if (const char *path = std::getenv("TANGOTREE_CONFIG"))
+      loadConfig(path, c);
+    setParallelCutoff(c.parallelCutoff);
+    return c;
+  }();
+  return config;
+}
+
 /* Constructor. */
-TangoTree::TangoTree(int n) {
+TangoTree::TangoTree(int n)
+    : count(std::max(n, 0)), deleted(0), low(1), high(n), monoid(nullptr), filterBits(0), isFrozen(false), maxFingers(0), epoch(0),
+      removals(0), version(0), coldAge(0), aux(&RedBlackAuxiliary) {
   root = buildTango(1, n);
-  root->isExternal = false;
-  root->blackHeight = 0;
+  if (root != Node::nil) {
+    root->isExternal = false;
+    root->blackHeight = 0;
+  }
+  configure(defaults());
+}
+
+/* Constructor. */
+TangoTree::TangoTree(const std::vector<int> &keys) : TangoTree(keys.data(), keys.size()) {}
+
+/* Constructor. */
+TangoTree::TangoTree(const int *keys, int n)
+    : count(std::max(n, 0)), deleted(0), low(n > 0 ? keys[0] : 1), high(n > 0 ? keys[n - 1] : 0), monoid(nullptr), filterBits(0), isFrozen(false),
+      maxFingers(0), epoch(0), removals(0), version(0), coldAge(0), aux(&RedBlackAuxiliary) {
+  root = buildTango(keys, 0, count - 1, 0, spawnLevels(count));
+  if (root != Node::nil) {
+    root->isExternal = false;
+    root->blackHeight = 0;
+  }
+  configure(defaults());
+}
+
+/* Constructor. */
+TangoTree::TangoTree(std::vector<Node *> nodes, const Monoid *m)
+    : count(nodes.size()), deleted(0), low(nodes.empty() ? 1 : nodes.front()->key), high(nodes.empty() ? 0 : nodes.back()->key), monoid(m),
+      filterBits(0), isFrozen(false), maxFingers(0), epoch(0), removals(0), version(0), coldAge(0), aux(&RedBlackAuxiliary) {
+  root = linkTango(nodes, 0, count - 1);
+  if (root != Node::nil) {
+    root->isExternal = false;
+    root->blackHeight = 0;
+  }
+  configure(defaults());
 }
 
+/* Constructor. */
+TangoTree::TangoTree(const TangoTree *source)
+    : root(source->root), count(source->count), deleted(source->deleted), low(source->low), high(source->high), monoid(source->monoid), filterBits(0),
+      isFrozen(source->isFrozen), layout(source->layout), maxFingers(source->maxFingers), fingers(source->fingers), pinned(source->pinned),
+      epoch(source->epoch), removals(source->removals), version(source->version + 1),
+      coldAge(source->coldAge), aux(source->aux) {
+  if (root != Node::nil)
+    root->refs++;     // the whole tree is shared, copy on write.
+}
+
+/* Destructor. */
+TangoTree::~TangoTree() { destroyTango(root); }
+
+/* FromRedBlackTree. */
+TangoTree TangoTree::fromRedBlackTree(Node *rbt) {
+  std::vector<Node *> nodes;
+  flattenTango(rbt, nodes);
+  const Monoid *m = rbt->hasValue ? static_cast<MapNode *>(rbt)->monoid : nullptr;
+  return TangoTree(std::move(nodes), m);
+}
+
+/* ToRedBlackTree. */
+Node *TangoTree::toRedBlackTree() {
+  thaw();
+  version++;
+  root = ownTango(root);     // the nodes shared with a fork are copied first.
+  std::vector<Node *> nodes;
+  nodes.reserve(count);
+  flattenTango(root, nodes);
+
+  auto live = std::remove_if(nodes.begin(), nodes.end(), [](Node *x) {
+    if (!x->isDeleted)
+      return false;
+    deleteNode(x);     // drop the tombstone.
+    return true;
+  });
+  nodes.erase(live, nodes.end());
+  Node *rbt = build(nodes.data(), nodes.size());
+
+  root = Node::nil;
+  count = deleted = 0;
+  low = 1;
+  high = 0;
+  fingers.clear();
+  pinned.clear();
+  removals++;
+  setCacheSize(cache.size() / 2);     // drop the cached results.
+  if (filterBits > 0)
+    buildFilter();
+  return rbt;
+}
+
+/* Fork. */
+TangoTree TangoTree::fork() { return TangoTree(this); }
+
 /* Show. */
-void TangoTree::show() { showRec(root); }
+void TangoTree::show() {
+  if (isFrozen)
+    showLayout(layout, 1);
+  else
+    showRec(root);
+}
+
+/* Access. */
+Node *TangoTree::access(int key) {
+  version++;
+  Node *x = accessTango(root, key, ++epoch, *aux);
+  if (aux == &BiasedAuxiliary) {
+    if (x != Node::nil)
+      root = biasedTouch(root, key);     // the key moves up its preferred path.
+    if (epoch % std::max(count, 64) == 0)
+      decay(root);
+  }
+  if (coldAge > 0 && epoch % coldAge == 0)     // periodic sweep, the root preferred path (and x) is never compressed.
+    compress(coldAge);
+  return x;
+}
+
+/* NewKeyNode. */
+Node *TangoTree::newKeyNode(int key, int depth) { return monoid != nullptr ? newMapNode(key, monoid->identity, monoid, depth) : newNode(key, depth); }
+
+/* Refresh. */
+void TangoTree::refresh(int key) { augmentPath(root, key); }
+
+/* FingerOf. */
+Finger TangoTree::fingerOf(Node *x) {
+  // The root preferred path keys with depth at least x's depth are x and the path below it, all inside x's reference
+  // subtree. The keys right before and after them in the root path are x's nearest ancestors on each side.
+  Node *prev = predecessor(root, x->depth);
+  Node *next = successor(root, x->depth);
+  // the searched subtree is the one of x's ancestor a few levels up, bounded by that ancestor's neighbours. The first
+  // root path node between them on the search path of x is its top in the tree: the nodes above it are outside, so its
+  // subtree holds every key between the bounds.
+  int depth = std::max(x->depth - FINGER_LEVELS, 0);
+  Node *lo = depth == x->depth ? prev : predecessor(root, depth);
+  Node *hi = depth == x->depth ? next : successor(root, depth);
+  long long low = lo == Node::nil ? INT_MIN - 1LL : lo->key, high = hi == Node::nil ? INT_MAX + 1LL : hi->key;
+  Node *top = root;
+  while (top->key <= low || top->key >= high)
+    top = top->key <= low ? top->right : top->left;
+  return {x->key, prev == Node::nil || prev->isDeleted ? x->key : prev->key, next == Node::nil || next->isDeleted ? x->key : next->key, true, removals,
+          top, low, high, version};
+}
+
+/* Rebuild. */
+void TangoTree::rebuild() {
+  root = ownTango(root);     // the nodes shared with a fork are copied first.
+  std::vector<Node *> nodes;
+  nodes.reserve(count);
+  flattenTango(root, nodes);
+  relink(nodes);
+}
+
+/* Relink. */
+void TangoTree::relink(std::vector<Node *> &nodes) {
+  version++;
+  dropTombstones(nodes);
+  count = nodes.size();
+  deleted = 0;
+
+  root = linkTango(nodes, 0, count - 1, 0, spawnLevels(count));
+  if (root != Node::nil) {
+    root->isExternal = false;
+    root->blackHeight = 0;
+  }
+
+  low = count > 0 ? nodes.front()->key : 1;     // shrink the key range to the live keys.
+  high = count > 0 ? nodes.back()->key : 0;
+  if (filterBits > 0)
+    buildFilter();
+}
+
+/* RebuildSubtree. */
+void TangoTree::rebuildSubtree(int key, int depth) {
+  version++;
+  // cut leaves the root path nodes of the subtree, and so the whole subtree, in an external subtree hanging from the
+  // root path where the key is searched.
+  root = cut(root, depth, epoch, *aux);
+  auto [q, p] = search(root, key);
+  Node *&slot = p->left == q ? p->left : p->right;
+  slot = ownTango(q);
+
+  std::vector<Node *> nodes;
+  flattenTango(slot, nodes);
+  int dropped = dropTombstones(nodes);
+  count -= dropped;
+  deleted -= dropped;
+  slot = linkTango(nodes, 0, (int)nodes.size() - 1, depth);     // the live key count, and so p's size, is unchanged.
+}
+
+/* Rebalance. */
+void TangoTree::rebalance(int key, int depth) {
+  access(key);     // the reference path of the key becomes the root preferred path.
+  for (int d = depth - 1; d > 0; d--) {
+    // the subtree of the path node at depth d holds the keys between its nearest ancestors on each side.
+    Node *pred = predecessor(root, d);
+    Node *succ = successor(root, d);
+    int below = (succ == Node::nil ? size() : ::rank(root, succ->key)) - (pred == Node::nil ? 0 : ::rank(root, pred->key) + (pred->isDeleted ? 0 : 1));
+    if (depth - d > depthBound(below)) {
+      rebuildSubtree(key, d);
+      return;
+    }
+  }
+  rebuild();
+}
+
+/* BuildFilter. */
+void TangoTree::buildFilter() {
+  if (isFrozen) {     // the keys are in the layout, the tree is empty.
+    filter = BloomFilter(2 * count, filterBits);
+    for (size_t k = 1; k < layout.size(); k++)
+      filter.add(layout[k]);
+    return;
+  }
+  std::vector<Node *> nodes, decoded;
+  nodes.reserve(count);
+  collectTango(root, nodes, decoded);
+
+  filter = BloomFilter(2 * count, filterBits);
+  for (Node *x : nodes)
+    if (!x->isDeleted)
+      filter.add(x->key);
+  for (Node *x : decoded)
+    destroyTango(x);
+}
+
+/* CacheFind. */
+TangoTree::CacheLine *TangoTree::cacheFind(int key) {
+  if (cache.empty())
+    return nullptr;
+  unsigned h = (unsigned)key * 2654435769u;     // Fibonacci hashing, folded so that the high bits reach the set index.
+  CacheLine *set = &cache[2 * ((h ^ (h >> 16)) & (cache.size() / 2 - 1))];
+  if (set[0].valid && set[0].key == key)
+    return &set[0];
+  if (set[1].valid && set[1].key == key) {
+    std::swap(set[0], set[1]);     // the way 0 holds the most recently used key.
+    return &set[0];
+  }
+  return nullptr;
+}
+
+/* CachePut. */
+void TangoTree::cachePut(int key, bool found) {
+  if (cache.empty())
+    return;
+  unsigned h = (unsigned)key * 2654435769u;
+  CacheLine *set = &cache[2 * ((h ^ (h >> 16)) & (cache.size() / 2 - 1))];
+  set[1] = set[0];     // evict the least recently used way.
+  set[0] = {key, found, true};
+}
 
 /* Contains. */
 bool TangoTree::contains(int key) {
-  auto [q, p] = search(root, key);
-  while (q->isExternal && q != Node::nil) {     // repeat until success or fail in the search.
-    root = tango(root, q);                      // perform a tango operation to updated the root preferred path.
-    std::tie(q, p) = search(root, key);         // update q and p reference for the next iteration.
+  if (!pinned.empty() && std::binary_search(pinned.begin(), pinned.end(), key))     // a pinned key.
+    return true;
+
+  if (CacheLine *line = cacheFind(key))     // resolved by the cache.
+    return line->found;
+
+  if (key < low || key > high || (filterBits > 0 && !filter.mayContain(key)))     // rejected by the filter.
+    return false;
+
+  if (isFrozen)
+    return frozenContains(key);
+
+  for (auto it = fingers.begin(); it != fingers.end(); ++it) {
+    if (covers(*it, key)) {                         // resolved by a finger.
+      std::rotate(fingers.begin(), it, it + 1);     // mark it as the most recently used.
+      return true;
+    }
+  }
+  for (auto it = fingers.begin(); it != fingers.end(); ++it) {
+    if (it->node == nullptr || it->version != version || key <= it->low || key >= it->high)
+      continue;
+    Node *x = searchFinger(*it, key);
+    if (x == nullptr)     // too far below the finger, searched from the root.
+      break;
+    std::rotate(fingers.begin(), it, it + 1);     // resolved in the finger subtree.
+    bool found = x != Node::nil && !x->isDeleted;
+    cachePut(key, found);
+    return found;
   }
 
-  if (q == Node::nil)     // failure search.
+  Node *x = access(key);
+  if (x == Node::nil || x->isDeleted) {     // failure search.
+    cachePut(key, false);
     return false;
+  }
+
+  if (maxFingers > 0) {
+    // the closest finger whose neighbourhood holds the key follows it, otherwise the least recently used one is dropped.
+    auto distance = [key](const Finger &f) { return std::abs((long long)f.key - key); };
+    auto follow = fingers.end();
+    for (auto it = fingers.begin(); it != fingers.end(); ++it)
+      if (near(*it, key) && (follow == fingers.end() || distance(*it) < distance(*follow)))
+        follow = it;
+    if (follow == fingers.end()) {
+      if ((int)fingers.size() == maxFingers)
+        fingers.pop_back();
+      fingers.push_back(Finger());
+      follow = fingers.end() - 1;
+    }
+    *follow = fingerOf(x);
+    std::rotate(fingers.begin(), follow, follow + 1);
+  }
+  cachePut(key, true);
   return true;     // successfully search.
-}
\ No newline at end of file
+}
+
+/* Rank. */
+int TangoTree::rank(int key) {
+  if (isFrozen)
+    return frozenRank(key);
+  access(key);     // the search path of the key becomes the root preferred path.
+  return ::rank(root, key);
+}
+
+/* Select. */
+int TangoTree::select(int i) {
+  assert(0 <= i && i < size());
+  if (isFrozen)
+    return frozenSelect(i);
+  int key = selectTango(root, i)->key;
+  access(key);
+  return key;
+}
+
+/* ContainsBatch. */
+void TangoTree::containsBatch(const int *keys, int n, bool *found) {
+  std::vector<int> order(n);
+  for (int i = 0; i < n; i++)
+    order[i] = i;
+  std::sort(order.begin(), order.end(), [keys](int a, int b) { return keys[a] < keys[b]; });
+
+  for (int j = 0; j < n; j++) {
+    int i = order[j];
+    if (j > 0 && keys[order[j - 1]] == keys[i])
+      found[i] = found[order[j - 1]];     // a repeated key.
+    else
+      found[i] = contains(keys[i]);
+  }
+}
+
+/* Hint. */
+void TangoTree::hint(const int *keys, int n) {
+  if (isFrozen)     // the layout does not adapt.
+    return;
+  for (int i = n - 1; i >= 0; i--) {
+    int key = keys[i];
+    if (key < low || key > high || (filterBits > 0 && !filter.mayContain(key)))
+      continue;
+    Node *x = access(key);
+    cachePut(key, x != Node::nil && !x->isDeleted);
+  }
+}
+
+/* SetBiased. */
+void TangoTree::setBiased(bool enabled) {
+  const AuxiliaryTree *next = enabled ? &BiasedAuxiliary : &RedBlackAuxiliary;
+  if (next == aux)
+    return;
+  aux = next;
+  if (!isFrozen)     // the auxiliary trees of the other kind become single node paths.
+    rebuild();
+}
+
+/* ResetAdaptation. */
+void TangoTree::resetAdaptation() {
+  if (!isFrozen)     // the frozen layout does not adapt.
+    rebuild();
+}
+
+/* SetFingerMode. */
+void TangoTree::setFingerMode(bool enabled) { setFingerCount(enabled ? 1 : 0); }
+
+/* SetFingerCount. */
+void TangoTree::setFingerCount(int k) {
+  maxFingers = std::max(k, 0);
+  fingers.clear();
+  fingers.reserve(maxFingers);
+}
+
+/* Pin. */
+bool TangoTree::pin(int key) {
+  auto it = std::lower_bound(pinned.begin(), pinned.end(), key);
+  if (it != pinned.end() && *it == key)
+    return true;
+  if (!contains(key))
+    return false;
+  pinned.insert(it, key);
+  return true;
+}
+
+/* Unpin. */
+bool TangoTree::unpin(int key) {
+  auto it = std::lower_bound(pinned.begin(), pinned.end(), key);
+  if (it == pinned.end() || *it != key)
+    return false;
+  pinned.erase(it);
+  return true;
+}
+
+/* SetCacheSize. */
+void TangoTree::setCacheSize(int sets) {
+  int size = 1;
+  while (size < sets)
+    size <<= 1;
+  cache.assign(sets > 0 ? 2 * size : 0, CacheLine());
+}
+
+/* SetFilter. */
+void TangoTree::setFilter(int bitsPerKey) {
+  filterBits = std::max(bitsPerKey, 0);
+  filter = BloomFilter();
+  if (filterBits > 0)
+    buildFilter();
+}
+
+/* SetColdAge. */
+void TangoTree::setColdAge(unsigned accesses) { coldAge = accesses; }
+
+/* Configure. */
+void TangoTree::configure(const TangoConfig &config) {
+  setCacheSize(config.cacheSets);
+  setFilter(config.filterBits);
+  setFingerCount(config.fingers);
+  setColdAge(config.coldAge);
+  setBiased(config.biased);
+}
+
+/* SetDefaultConfig. */
+void TangoTree::setDefaultConfig(const TangoConfig &config) {
+  defaults() = config;
+  setParallelCutoff(config.parallelCutoff);
+}
+
+/* DefaultConfig. */
+TangoConfig TangoTree::defaultConfig() { return defaults(); }
+
+/* Compress. */
+int TangoTree::compress(unsigned age) {
+  if (monoid != nullptr)     // the stubs do not encode values.
+    return 0;
+  version++;
+  return coolTango(root, epoch, age);
+}
+
+/* AccessNear. */
+bool TangoTree::accessNear(Finger &handle, int key) {
+  if (handle.removals == removals && covers(handle, key))     // resolved by a finger no erase made stale.
+    return true;
+  if (isFrozen)
+    return frozenContains(key);
+  if (handle.node != nullptr && handle.version == version && handle.low < key && key < handle.high)
+    if (Node *x = searchFinger(handle, key))     // resolved in the finger subtree.
+      return x != Node::nil && !x->isDeleted;
+
+  Node *x = access(key);
+  if (x == Node::nil || x->isDeleted)
+    return false;
+  handle = fingerOf(x);
+  return true;
+}
+
+/* Insert. */
+bool TangoTree::insert(int key) {
+  if (isFrozen)
+    thaw();
+  if (CacheLine *line = cacheFind(key))
+    line->found = true;
+
+  if (filterBits > 0 && count >= filter.size())     // the filter is full, resize it.
+    buildFilter();
+  if (filterBits > 0)
+    filter.add(key);
+
+  if (root == Node::nil) {     // first key.
+    root = newKeyNode(key, 0);
+    root->color = BLACK;
+    count = 1;
+    low = high = key;
+    return true;
+  }
+  low = std::min(low, key);
+  high = std::max(high, key);
+
+  Node *x = access(key);
+  if (x != Node::nil) {
+    if (!x->isDeleted)
+      return false;
+    x->isDeleted = false;     // revive the tombstone.
+    deleted--;
+    augmentPath(root, key);
+    return true;
+  }
+
+  // The search failed in the root preferred path, so the whole reference path to the key is there. The new key is a
+  // reference leaf below the deeper of its two neighbours and hangs, as a single node preferred path, in the nil slot
+  // where the search ended.
+  Node *pred, *succ;
+  Node *parent = leafSlot(root, key, pred, succ);
+
+  int depth = std::max(pred->depth, succ->depth) + 1;
+  Node *z = newKeyNode(key, depth);
+  z->isExternal = true;
+  z->blackHeight = -1;
+  z->color = BLACK;
+  (key < parent->key ? parent->left : parent->right) = z;
+  augmentPath(root, key);
+
+  count++;
+  if (depth > depthBound(count))
+    rebalance(key, depth);
+  return true;
+}
+
+/* InsertBatch. */
+int TangoTree::insertBatch(const int *keys, int n) {
+  if (n == 0)
+    return 0;
+  if (isFrozen)
+    thaw();
+  for (int i = 0; i < n; i++)
+    if (CacheLine *line = cacheFind(keys[i]))
+      line->found = true;
+
+  int inserted = 0;
+  if (n >= size()) {     // a large batch is merged with all the nodes, which are relinked.
+    root = ownTango(root);
+    std::vector<Node *> nodes, merged;
+    nodes.reserve(count);
+    flattenTango(root, nodes);
+    merged.reserve(nodes.size() + n);
+    size_t a = 0;
+    for (int i = 0; i < n; i++) {
+      if (i > 0 && keys[i] == keys[i - 1])
+        continue;
+      while (a < nodes.size() && nodes[a]->key < keys[i])
+        merged.push_back(nodes[a++]);
+      if (a < nodes.size() && nodes[a]->key == keys[i]) {
+        inserted += nodes[a]->isDeleted ? 1 : 0;
+        nodes[a]->isDeleted = false;     // revive the tombstone.
+        merged.push_back(nodes[a++]);
+      } else {
+        merged.push_back(newKeyNode(keys[i], 0));
+        inserted++;
+      }
+    }
+    merged.insert(merged.end(), nodes.begin() + a, nodes.end());
+    relink(merged);
+    return inserted;
+  }
+
+  low = std::min(low, keys[0]);
+  high = std::max(high, keys[n - 1]);
+  for (int i = 0; i < n;) {
+    int key = keys[i];
+    Node *x = access(key);
+    if (x != Node::nil) {
+      if (x->isDeleted) {
+        x->isDeleted = false;     // revive the tombstone.
+        deleted--;
+        augmentPath(root, key);
+        inserted++;
+        if (filterBits > 0)       // the filter may have been rebuilt while the key was erased.
+          filter.add(key);
+      }
+      for (; i < n && keys[i] == key; i++)
+        ;
+      continue;
+    }
+
+    // The keys of the batch up to the successor of the key fall in the same nil slot. They hang there as a balanced
+    // reference subtree, below the deeper of the two neighbours, one access for the whole run.
+    Node *pred, *succ;
+    Node *parent = leafSlot(root, key, pred, succ);
+    std::vector<Node *> run;
+    for (; i < n && (succ == Node::nil || keys[i] < succ->key); i++)
+      if (run.empty() || keys[i] != run.back()->key)
+        run.push_back(newKeyNode(keys[i], 0));
+    (key < parent->key ? parent->left : parent->right) = linkTango(run, 0, run.size() - 1, std::max(pred->depth, succ->depth) + 1);
+    augmentPath(root, key);
+    count += run.size();
+    inserted += run.size();
+
+    if (filterBits > 0 && count >= filter.size())
+      buildFilter();
+    else if (filterBits > 0)
+      for (Node *z : run)
+        filter.add(z->key);
+    Node *deepest = run.back();     // linkTango leaves the last node of a range at its bottom level.
+    if (deepest->depth > depthBound(count))
+      rebalance(deepest->key, deepest->depth);
+  }
+  return inserted;
+}
+
+/* Erase. */
+bool TangoTree::erase(int key) {
+  if (isFrozen)
+    thaw();
+  if (CacheLine *line = cacheFind(key))
+    line->found = false;
+
+  Node *x = access(key);
+  if (x == Node::nil || x->isDeleted)
+    return false;
+
+  x->isDeleted = true;
+  deleted++;
+  augmentPath(root, key);
+  // fingers only hold keys known to be in the tree, so the ones resolving the erased key are dropped.
+  fingers.erase(std::remove_if(fingers.begin(), fingers.end(), [key](const Finger &f) { return covers(f, key); }), fingers.end());
+  unpin(key);
+  removals++;
+
+  if (2 * deleted > count)
+    rebuild();
+  return true;
+}
+
+/* PushBack. */
+bool TangoTree::pushBack(int key) {
+  if (isFrozen)
+    thaw();
+  if (root == Node::nil || key <= high)     // not known to be above every node.
+    return insert(key);
+  if (CacheLine *line = cacheFind(key))
+    line->found = true;
+
+  if (filterBits > 0 && count >= filter.size())
+    buildFilter();
+  if (filterBits > 0)
+    filter.add(key);
+  high = key;
+
+  Node *z = newKeyNode(key, 0);
+  z->isExternal = true;
+  z->blackHeight = -1;
+  z->color = BLACK;
+  z->stamp = epoch;
+  version++;     // the right path may be expanded or copied.
+  int depth = appendTango(root, z);
+
+  count++;
+  if (depth > depthBound(count))
+    rebalance(key, depth);
+  return true;
+}
+
+/* PopFront. */
+int TangoTree::popFront() {
+  assert(size() > 0);
+  if (isFrozen)
+    thaw();
+  version++;     // the left path may be expanded or copied.
+  int key = eraseMinTango(root)->key;
+  if (CacheLine *line = cacheFind(key))
+    line->found = false;
+  fingers.erase(std::remove_if(fingers.begin(), fingers.end(), [key](const Finger &f) { return covers(f, key); }), fingers.end());
+  unpin(key);
+  removals++;
+  deleted++;
+  low = key;     // every live key is greater now.
+
+  if (2 * deleted > count)
+    rebuild();
+  return key;
+}
+
+/* Freeze. */
+void TangoTree::freeze() {
+  if (isFrozen)
+    return;
+
+  std::vector<Node *> nodes, decoded;
+  nodes.reserve(count);
+  collectTango(root, nodes, decoded);
+
+  std::vector<int> keys;
+  keys.reserve(count - deleted);
+  for (Node *x : nodes)
+    if (!x->isDeleted)
+      keys.push_back(x->key);
+  destroyTango(root);
+  for (Node *x : decoded)
+    destroyTango(x);
+
+  layout.assign(keys.size() + 1, 0);
+  mapLayoutParallel(keys.data(), layout.data(), keys.size(), 1, 0, true, spawnLevels(keys.size()));
+
+  root = Node::nil;
+  count = keys.size();
+  deleted = 0;
+  isFrozen = true;
+  version++;
+}
+
+/* Thaw. */
+void TangoTree::thaw() {
+  if (!isFrozen)
+    return;
+
+  std::vector<int> keys(layout.size() - 1);
+  mapLayoutParallel(keys.data(), layout.data(), keys.size(), 1, 0, false, spawnLevels(keys.size()));
+  std::vector<int>().swap(layout);     // release the layout memory.
+  isFrozen = false;
+  version++;
+
+  root = buildTango(keys.data(), 0, count - 1, 0, spawnLevels(count));
+  if (root != Node::nil) {
+    root->isExternal = false;
+    root->blackHeight = 0;
+  }
+}
+
+/* FrozenContains. */
+bool TangoTree::frozenContains(int key) const {
+  const int *e = layout.data();
+  size_t m = layout.size() - 1;
+  size_t k = 1;
+  while (k <= m) {
+#if defined(__GNUC__)
+    __builtin_prefetch(e + 16 * k);     // the 16 keys four levels below, one cache line.
+#endif
+    k = 2 * k + (e[k] < key);     // branch free descent.
+  }
+  // the answer is the last node where the descent went left: drop the trailing right turns and that left turn.
+#if defined(__GNUC__)
+  k >>= __builtin_ffsll(~k);
+#else
+  while (k & 1)
+    k >>= 1;
+  k >>= 1;
+#endif
+  return k != 0 && e[k] == key;
+}
+
+/* FrozenRank. */
+int TangoTree::frozenRank(int key) const {
+  size_t m = layout.size() - 1;
+  int r = 0;
+  for (size_t k = 1; k <= m;) {
+    if (layout[k] < key) {
+      r += layoutSize(2 * k, m) + 1;     // the left subtree and the node are smaller than the key.
+      k = 2 * k + 1;
+    } else {
+      k = 2 * k;
+    }
+  }
+  return r;
+}
+
+/* FrozenSelect. */
+int TangoTree::frozenSelect(int i) const {
+  size_t m = layout.size() - 1;
+  size_t k = 1;
+  for (size_t left = layoutSize(2, m); (size_t)i != left; left = layoutSize(2 * k, m)) {
+    if ((size_t)i < left) {
+      k = 2 * k;
+    } else {
+      i -= left + 1;
+      k = 2 * k + 1;
+    }
+  }
+  return layout[k];
+}
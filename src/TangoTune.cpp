@@ -0,0 +1,196 @@
+/**
+ * @file TangoTune.cpp
+ * @author Zawarudo (@zawarudo)
+ * @version 1.0
+ * @date 2026-10-18
+ * @copyright Copyright (c) 2026
+ *
+ * Implementation of the calibration routine defined in TangoTune.h. Every setting is timed a few times on a fresh tree
+ * and the best time is kept, which filters out most of the noise of a shared host.
+ */
+
+// includes.
+#include "TangoTune.h"
+#include "TangoPool.h"
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <random>
+#include <thread>
+
+// defines.
+#define RUNS 3                   // number of timed runs per setting, the best one counts.
+#define MIN_GAIN 0.9             // time ratio a larger setting must reach against the best one so far to replace it.
+#define MIN_PARALLEL 4096        // smallest construction size timed for the parallel cutoff.
+#define MAX_PARALLEL (1 << 20)   // largest construction size timed for the parallel cutoff.
+
+/* Auxiliary functions. */
+
+/**
+ * @brief Returns the best time of a few runs of the given benchmark.
+ *
+ * @param run The benchmark. It prepares its input and returns the time of the measured part, in seconds.
+ * @return The best time, in seconds.
+ */
+template <typename Run>
+double bestTime(Run run) {
+  double best = run();
+  for (int i = 1; i < RUNS; i++)
+    best = std::min(best, run());
+  return best;
+}
+
+/**
+ * @brief Returns the time elapsed since the given instant.
+ *
+ * @param start The instant.
+ * @return The elapsed time, in seconds.
+ */
+double since(std::chrono::steady_clock::time_point start) {
+  return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+}
+
+/**
+ * @brief Times the queries on a fresh tree with the given configuration.
+ *
+ * @param keys The tree keys.
+ * @param queries The queries.
+ * @param config The tree configuration.
+ * @return The time of the queries, in seconds.
+ */
+double timeQueries(const std::vector<int> &keys, const std::vector<int> &queries, const TangoConfig &config) {
+  TangoTree tree(keys);
+  tree.configure(config);
+  auto start = std::chrono::steady_clock::now();
+  int found = 0;
+  for (int key : queries)
+    found += tree.contains(key) ? 1 : 0;
+  double time = since(start);
+  volatile int sink = found;     // keeps the searches from being optimized away.
+  (void)sink;
+  return time;
+}
+
+/**
+ * @brief Times a pool going through the life of many small trees: created in bulk, searched and destroyed. The pool
+ * takes its slab size from the default configuration.
+ *
+ * @param keySets The key sets of the trees.
+ * @return The time, in seconds.
+ */
+double timePool(const std::vector<std::vector<int>> &keySets) {
+  auto start = std::chrono::steady_clock::now();
+  TangoPool pool;
+  std::vector<int> ids = pool.createBulk(keySets);
+  int found = 0;
+  for (size_t t = 0; t < ids.size(); t++)
+    for (int key : {keySets[t].front(), keySets[t].back(), keySets[t].back() + 1})
+      found += pool.contains(ids[t], key) ? 1 : 0;
+  pool.destroyBulk(ids);
+  ids = pool.createBulk(keySets);     // the blocks are reused.
+  pool.clear();
+  double time = since(start);
+  volatile int sink = found;
+  (void)sink;
+  return time;
+}
+
+/**
+ * @brief Chooses the value of one knob among the given candidates, in increasing order. A candidate replaces the best
+ * one so far only if it is clearly faster.
+ *
+ * @param candidates The candidate values.
+ * @param time The benchmark of a candidate, returning its best time.
+ * @return The chosen value.
+ */
+template <typename Time>
+int choose(const std::vector<int> &candidates, Time time) {
+  int chosen = candidates[0];
+  double best = time(chosen);
+  for (size_t i = 1; i < candidates.size(); i++) {
+    double t = time(candidates[i]);
+    if (t < MIN_GAIN * best) {
+      chosen = candidates[i];
+      best = t;
+    }
+  }
+  return chosen;
+}
+
+/* Calibrate. */
+
+TangoConfig calibrate(int n, const TangoConfig &base) {
+  TangoConfig config = base;
+  n = std::max(n, 64);
+  std::mt19937 g(n);
+
+  // even keys, so that the odd keys inside the range are absent.
+  std::vector<int> keys(n);
+  for (int i = 0; i < n; i++)
+    keys[i] = 2 * i;
+  std::vector<int> hot(n / 64);
+  for (int &key : hot)
+    key = keys[g() % n];
+  std::vector<int> queries(n);
+  for (int &key : queries) {
+    unsigned r = g() % 4;
+    if (r < 2)
+      key = hot[g() % hot.size()];     // skewed hits.
+    else if (r == 2)
+      key = keys[g() % n];             // uniform hits.
+    else
+      key = 2 * (int)(g() % n) + 1;    // absent keys.
+  }
+
+  config.cacheSets = choose({0, 256, 2048, 16384}, [&](int sets) {
+    TangoConfig c = config;
+    c.cacheSets = sets;
+    c.filterBits = 0;
+    return bestTime([&] { return timeQueries(keys, queries, c); });
+  });
+  config.filterBits = choose({0, 8, 12, 16}, [&](int bits) {
+    TangoConfig c = config;
+    c.filterBits = bits;
+    return bestTime([&] { return timeQueries(keys, queries, c); });
+  });
+
+  // small trees of 8 to 71 keys, about n keys in all.
+  std::vector<std::vector<int>> keySets(std::max(n / 40, 16));
+  for (std::vector<int> &set : keySets)
+    for (int key = 0, size = 8 + g() % 64; key < size; key++)
+      set.push_back(3 * key);
+  TangoConfig defaults = TangoTree::defaultConfig();
+  size_t saved = parallelCutoff();     // setDefaultConfig sets it too.
+  config.slabBytes = choose({1 << 14, 1 << 16, 1 << 18, 1 << 20}, [&](int bytes) {
+    TangoConfig c = defaults;
+    c.slabBytes = bytes;
+    TangoTree::setDefaultConfig(c);
+    return bestTime([&] { return timePool(keySets); });
+  });
+  TangoTree::setDefaultConfig(defaults);
+  setParallelCutoff(saved);
+
+  if (std::thread::hardware_concurrency() > 1) {     // otherwise the constructions never use more than one thread.
+    size_t cutoff = 2 * MAX_PARALLEL;
+    for (size_t m = MIN_PARALLEL; m <= MAX_PARALLEL; m *= 2) {
+      std::vector<int> sample(keys.begin(), keys.begin() + std::min(m, keys.size()));
+      for (size_t i = sample.size(); i < m; i++)
+        sample.push_back(2 * (int)i);
+      auto build = [&](size_t c) {
+        setParallelCutoff(c);
+        return bestTime([&] {
+          auto start = std::chrono::steady_clock::now();
+          TangoTree tree(sample);
+          return since(start);
+        });
+      };
+      if (build(1) < MIN_GAIN * build(SIZE_MAX)) {
+        cutoff = m;
+        break;
+      }
+    }
+    setParallelCutoff(saved);
+    config.parallelCutoff = cutoff;
+  }
+  return config;
+}
@@ -0,0 +1,64 @@
+/**
+ * @file TieredTangoTree.cpp
+ * @author Zawarudo (@zawarudo)
+ * @version 1.0
+ * @date 2026-10-18
+ * @copyright Copyright (c) 2026
+ *
+ * Implementation of the tiered key store defined in TieredTangoTree.h. The cold tier is a Tango Tree frozen right after
+ * its construction, and the hot tier is rebuilt from scratch at each tier update, which costs O(k log k) for k hot keys
+ * and keeps it in the balanced configuration the new hot set starts from.
+ */
+
+// includes.
+#include "TieredTangoTree.h"
+#include <algorithm>
+
+// defines.
+#define HOT_FILTER_BITS 12     // Bloom filter bits per hot key, so that cold keys rarely reach the hot tree nodes.
+
+/* Constructor. */
+TieredTangoTree::TieredTangoTree(const std::vector<int> &keys, int hotCapacity, int epochLength)
+    : cold(keys), hot(new TangoTree(0)), hotCapacity(hotCapacity), epochLength(std::max(epochLength, 1)), accesses(0), hotKeys(0) {
+  cold.freeze();
+}
+
+/* Contains. */
+bool TieredTangoTree::contains(int key) {
+  bool found = hot->contains(key) || cold.contains(key);
+  if (found)
+    counts[key]++;
+  if (++accesses == epochLength)
+    retier();
+  return found;
+}
+
+/* Retier. */
+void TieredTangoTree::retier() {
+  std::vector<std::pair<unsigned, int>> ranked;     // (count, key) of the keys seen more than once.
+  ranked.reserve(counts.size());
+  for (auto &[key, count] : counts)
+    if (count > 1)
+      ranked.push_back({count, key});
+
+  if ((int)ranked.size() > hotCapacity) {     // keep the hotCapacity keys with the highest counts.
+    std::nth_element(ranked.begin(), ranked.begin() + hotCapacity, ranked.end(), std::greater<std::pair<unsigned, int>>());
+    ranked.resize(hotCapacity);
+  }
+
+  std::vector<int> keys;
+  keys.reserve(ranked.size());
+  for (auto &entry : ranked)
+    keys.push_back(entry.second);
+  std::sort(keys.begin(), keys.end());
+
+  hot.reset(new TangoTree(keys));
+  hot->setFilter(HOT_FILTER_BITS);
+  hotKeys = keys.size();
+
+  for (auto it = counts.begin(); it != counts.end();) {     // decay the counts.
+    it->second >>= 1;
+    it = it->second == 0 ? counts.erase(it) : std::next(it);
+  }
+  accesses = 0;
+}
@@ -0,0 +1,70 @@
+#include <gtest/gtest.h>
+#include <climits>
+#include <random>
+#include <vector>
+#include "BiasedTree.h"
+
+/**
+ * @brief Validates the given biased tree: search tree order, heap order of the heats and subtree sizes.
+ *
+ * @param root The tree root.
+ * @param keys The vector where the keys are appended in order.
+ * @return True, if the tree is valid; false, otherwise.
+ */
+bool isBiased(Node *root, std::vector<int> &keys) {
+    if (root->isExternal) return true;
+    if (!root->left->isExternal && root->left->heat > root->heat) return false;
+    if (!root->right->isExternal && root->right->heat > root->heat) return false;
+    if (root->size != root->left->size + root->right->size + 1) return false;
+    if (!isBiased(root->left, keys)) return false;
+    keys.push_back(root->key);
+    return isBiased(root->right, keys);
+}
+
+// Helper to build a biased tree over the keys [l, r) with joins
+Node *join_keys(int l, int r) {
+    Node *root = Node::nil;
+    for (int key = l; key < r; ++key)
+        root = biasedJoin(root, newNode(key), Node::nil);
+    return root;
+}
+
+// Test joins, splits and min/max removals against the key order
+TEST(BiasedTreeTest, SplitAndJoin) {
+    Node *root = biasedJoin(join_keys(0, 500), newNode(500), join_keys(501, 1000));
+    std::vector<int> keys;
+    ASSERT_TRUE(isBiased(root, keys));
+    ASSERT_EQ((int)keys.size(), 1000);
+    for (int i = 0; i < 1000; ++i)
+        ASSERT_EQ(keys[i], i);
+
+    auto [left, x, right] = biasedSplit(root, 300);
+    EXPECT_EQ(x->key, 300);
+    EXPECT_EQ(left->size, 300);
+    EXPECT_EQ(right->size, 699);
+
+    auto [min, rest] = biasedDeleteMin(right);
+    EXPECT_EQ(min->key, 301);
+    auto [max, middle] = biasedDeleteMax(rest);
+    EXPECT_EQ(max->key, 999);
+    root = biasedJoin(left, x, middle);
+    keys.clear();
+    ASSERT_TRUE(isBiased(root, keys));
+    EXPECT_EQ(root->size, 998);
+    EXPECT_EQ(keys.back(), 998);
+}
+
+// Test that the hot keys rise to the root and that decay keeps the order
+TEST(BiasedTreeTest, TouchAndDecay) {
+    Node *root = join_keys(0, 1000);
+    std::mt19937 g(11);
+    for (int i = 0; i < 5000; ++i)
+        root = biasedTouch(root, i % 2 == 0 ? 777 : g() % 1000);
+    EXPECT_EQ(root->key, 777);
+
+    decay(root);
+    std::vector<int> keys;
+    ASSERT_TRUE(isBiased(root, keys));
+    ASSERT_EQ((int)keys.size(), 1000);
+    EXPECT_EQ(search(root, 123).first->key, 123);
+}
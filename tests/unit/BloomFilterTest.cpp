@@ -0,0 +1,34 @@
+#include <gtest/gtest.h>
+#include <random>
+#include "BloomFilter.h"
+
+// Test that an empty filter rejects every key
+TEST(BloomFilterTest, EmptyFilter) {
+    BloomFilter filter;
+    EXPECT_TRUE(filter.empty());
+    EXPECT_FALSE(filter.mayContain(0));
+    EXPECT_FALSE(filter.mayContain(42));
+}
+
+// Test that the filter has no false negatives
+TEST(BloomFilterTest, NoFalseNegatives) {
+    const int N = 10000;
+    BloomFilter filter(N, 10);
+    for (int i = 0; i < N; ++i)
+        filter.add(3 * i - N);
+    for (int i = 0; i < N; ++i)
+        ASSERT_TRUE(filter.mayContain(3 * i - N)) << "False negative for key: " << 3 * i - N;
+}
+
+// Test that the false positive rate stays low with 10 bits per key
+TEST(BloomFilterTest, FalsePositiveRate) {
+    const int N = 10000;
+    BloomFilter filter(N, 10);
+    for (int i = 0; i < N; ++i)
+        filter.add(2 * i);
+
+    int falsePositives = 0;
+    for (int i = 0; i < N; ++i)
+        falsePositives += filter.mayContain(2 * i + 1);
+    EXPECT_LT(falsePositives, N / 20);   // well below 5%
+}
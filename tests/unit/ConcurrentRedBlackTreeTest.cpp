@@ -0,0 +1,79 @@
+#include <gtest/gtest.h>
+#include <atomic>
+#include <random>
+#include <set>
+#include <thread>
+#include <vector>
+#include "ConcurrentRedBlackTree.h"
+
+// Test the tree against a std::set from a single thread
+TEST(ConcurrentRedBlackTreeTest, SingleThread) {
+    ConcurrentRedBlackTree tree;
+    std::set<int> keys;
+    std::mt19937 g(7);
+    for (int q = 0; q < 50000; ++q) {
+        int key = g() % 5000;
+        if (g() % 4 == 0 && !keys.empty()) {
+            int min;
+            ASSERT_TRUE(tree.deleteMin(min));
+            ASSERT_EQ(min, *keys.begin());
+            keys.erase(keys.begin());
+        } else if (g() % 2 == 0) {
+            ASSERT_EQ(tree.insert(key), keys.insert(key).second);
+        } else {
+            ASSERT_EQ(tree.contains(key), keys.count(key) == 1) << "Wrong result for key: " << key;
+        }
+        ASSERT_EQ(tree.size(), (long)keys.size());
+    }
+    int min;
+    while (tree.deleteMin(min)) {
+        ASSERT_EQ(min, *keys.begin());
+        keys.erase(keys.begin());
+    }
+    EXPECT_TRUE(keys.empty());
+}
+
+// Test searches running while writers rebalance the tree
+TEST(ConcurrentRedBlackTreeTest, ReadersAndWriters) {
+    ConcurrentRedBlackTree tree;
+    int n = 20000;
+    for (int key = 0; key < n; ++key)
+        tree.insert(2 * key);     // the even keys stay, the writers only remove keys they insert below them.
+
+    std::atomic<bool> done(false);
+    std::atomic<int> errors(0);
+    std::vector<std::thread> readers;
+    for (int t = 0; t < 4; ++t)
+        readers.emplace_back([&, t] {
+            std::mt19937 g(t);
+            while (!done.load()) {
+                int key = g() % (2 * n);
+                if (tree.contains(key) != (key % 2 == 0))
+                    errors++;
+            }
+        });
+
+    std::vector<std::thread> writers;
+    for (int t = 0; t < 2; ++t)
+        writers.emplace_back([&, t] {
+            for (int i = 0; i < 5000; ++i) {
+                tree.insert(-1 - 2 * (i * 2 + t));     // odd negative keys, smaller than every even key.
+                int min;
+                if (i % 2 == 1)
+                    tree.deleteMin(min);
+            }
+        });
+    for (std::thread &w : writers)
+        w.join();
+    done = true;
+    for (std::thread &r : readers)
+        r.join();
+
+    EXPECT_EQ(errors.load(), 0);
+    EXPECT_EQ(tree.size(), n + 5000);
+    int min;
+    while (tree.size() > n)
+        tree.deleteMin(min);
+    for (int key = -1; key < 2 * n; ++key)
+        ASSERT_EQ(tree.contains(key), key >= 0 && key % 2 == 0);
+}
@@ -0,0 +1,36 @@
+#include <gtest/gtest.h>
+#include <cstdio>
+#include <string>
+#include <vector>
+#include "KeyFile.h"
+
+// Helper to write a key file with the given keys
+std::string write_keys(const std::string &name, const std::vector<int> &keys) {
+    std::string path = testing::TempDir() + name;
+    FILE *f = fopen(path.c_str(), "wb");
+    if (!keys.empty()) fwrite(keys.data(), sizeof(int), keys.size(), f);
+    fclose(f);
+    return path;
+}
+
+// Test mapping a sorted key file
+TEST(KeyFileTest, MapsSortedKeys) {
+    std::vector<int> keys;
+    for (int i = -500; i < 500; ++i) keys.push_back(7 * i);
+    KeyFile file;
+    ASSERT_TRUE(file.open(write_keys("sorted.bin", keys).c_str()));
+    ASSERT_EQ(file.size(), keys.size());
+    for (size_t i = 0; i < keys.size(); ++i)
+        ASSERT_EQ(file.data()[i], keys[i]);
+}
+
+// Test empty, unsorted and missing files
+TEST(KeyFileTest, RejectsInvalidFiles) {
+    KeyFile file;
+    EXPECT_TRUE(file.open(write_keys("empty.bin", {}).c_str()));
+    EXPECT_EQ(file.size(), 0u);
+    EXPECT_FALSE(file.open(write_keys("unsorted.bin", {1, 3, 2}).c_str()));
+    EXPECT_FALSE(file.open(write_keys("duplicates.bin", {1, 2, 2}).c_str()));
+    EXPECT_FALSE(file.open((testing::TempDir() + "missing.bin").c_str()));
+    EXPECT_EQ(file.size(), 0u);
+}
@@ -1,5 +1,6 @@
 #include <gtest/gtest.h>
 #include <climits>
+#include <vector>
 #include "RedBlackTree.h"
 
 /**************************************************************
@@ -281,6 +282,72 @@ TEST_F(RedBlackTreeTest, deleteMaxValue1) {
     }
 }
 
+/* Build */
+
+TEST(RedBlackTreeBuildTest, BuildFromSortedKeys) {
+    for (int n : {0, 1, 2, 3, 10, 1000, 70000}) {
+        std::vector<int> keys(n);
+        for (int i = 0; i < n; i++) keys[i] = 3 * i;
+        Node *tree = build(keys.data(), keys.size());
+
+        EXPECT_TRUE(check(tree)) << "Invariants failed after Build of " << n << " keys!";
+        EXPECT_EQ(tree->size, n);
+        for (int i = 0; i < n; i += 7) {
+            ASSERT_EQ(search(tree, 3 * i).first->key, 3 * i);
+            ASSERT_EQ(search(tree, 3 * i + 1).first, Node::nil);
+        }
+    }
+}
+
+/* PushBack & PopFront */
+
+TEST(RedBlackTreeWindowTest, SlidingWindow) {
+    Node *tree = Node::nil;
+    int front = 0, back = 0;
+    for (int step = 0; step < 5000; step++) {
+        int pushes = step % 7 < 4 ? 3 : 1;     // the window grows, then shrinks.
+        for (int i = 0; i < pushes; i++)
+            tree = pushBack(tree, back++);
+        if (front < back) {
+            auto [minNode, newRoot] = popFront(tree);
+            tree = newRoot;
+            ASSERT_EQ(minNode->key, front++);
+            deleteNode(minNode);
+        }
+        if (step % 100 == 0) {
+            ASSERT_TRUE(check(tree)) << "Invariants failed at step " << step;
+            ASSERT_EQ(tree->size, back - front);
+        }
+    }
+    while (front < back) {
+        auto [minNode, newRoot] = popFront(tree);
+        tree = newRoot;
+        ASSERT_EQ(minNode->key, front++);
+        deleteNode(minNode);
+        ASSERT_TRUE(check(tree));
+    }
+    EXPECT_EQ(tree, Node::nil);
+}
+
+/* Rank & Select */
+
+TEST_F(RedBlackTreeTest, RankAndSelect) {
+    EXPECT_EQ(root->size, n);
+    for (int i = 0; i < n; i++) {
+        EXPECT_EQ(rank(root, keys[i]), i);
+        EXPECT_EQ(select(root, i)->key, keys[i]);
+    }
+    EXPECT_EQ(rank(root, 0), 0);
+    EXPECT_EQ(rank(root, 6), 2);
+    EXPECT_EQ(rank(root, 100), n);
+    EXPECT_EQ(select(root, n), Node::nil);
+
+    auto [minNode, newRoot] = deleteMin(root);
+    root = newRoot;
+    EXPECT_EQ(root->size, n - 1);
+    EXPECT_EQ(select(root, 0)->key, 5);
+}
+
 /**************************************************************
  * Split Operations Tests
  **************************************************************/
@@ -327,6 +394,47 @@ TEST_F(SplitTreeTest, SplitAtMaximumNode) {
     EXPECT_NE(leftNode, Node::nil);
 }
 
+TEST_F(SplitTreeTest, SplitAtRankMiddle) {
+    // Splits at rank 3 (key 10)
+    auto [lTree, splitNode, rTree] = splitAtRank(root, 3);
+    resultLeft = lTree;
+    resultRight = rTree;
+
+    EXPECT_EQ(splitNode->key, 10);
+    EXPECT_EQ(resultLeft->size, 3);
+    EXPECT_EQ(resultRight->size, 1);
+    EXPECT_EQ(select(resultLeft, 2)->key, 7);
+    EXPECT_EQ(select(resultRight, 0)->key, 15);
+}
+
+TEST_F(SplitTreeTest, SplitAtRankZero) {
+    // Splits at rank 0 (the minimum). Left tree should be empty.
+    auto [lTree, splitNode, rTree] = splitAtRank(root, 0);
+    resultLeft = lTree;
+    resultRight = rTree;
+
+    EXPECT_EQ(resultLeft, Node::nil);
+    EXPECT_EQ(splitNode->key, 4);
+    EXPECT_EQ(resultRight->size, 4);
+}
+
+TEST_F(SplitTreeTest, SplitKeepsValueAggregates) {
+    // Builds a tree of map nodes (value = 10 * key) by joins, then splits it at 7
+    const Monoid sum = {0, [](long long a, long long b) { return a + b; }};
+    Node *tree = Node::nil;
+    for (int i = 0; i < n; i++)
+        tree = join(tree, newMapNode(keys[i], 10 * keys[i], &sum), Node::nil);
+    EXPECT_EQ(aggregate(tree, 0, 100, sum), 410);
+    EXPECT_EQ(aggregate(tree, 5, 10, sum), 220);
+
+    auto [lTree, splitNode, rTree] = split(tree, 7);
+    resultLeft = lTree;
+    resultRight = rTree;
+    EXPECT_EQ(static_cast<MapNode *>(resultLeft)->agg, 90);
+    EXPECT_EQ(static_cast<MapNode *>(resultRight)->agg, 250);
+    EXPECT_EQ(aggregate(resultRight, 11, 20, sum), 150);
+}
+
 /**************************************************************
  * Join Operations Tests
  **************************************************************/
@@ -0,0 +1,56 @@
+#include <gtest/gtest.h>
+#include <algorithm>
+#include <random>
+#include <set>
+#include <vector>
+#include "SparseTangoTree.h"
+
+class SparseTangoTreeTest : public ::testing::Test {
+protected:
+    // Helper to generate n distinct random 64-bit keys
+    std::vector<uint64_t> generate_random_keys(int n) {
+        std::mt19937_64 g(7);
+        std::set<uint64_t> keys;
+        while ((int)keys.size() < n) keys.insert(g());
+        std::vector<uint64_t> result(keys.begin(), keys.end());
+        std::shuffle(result.begin(), result.end(), g);
+        return result;
+    }
+};
+
+// Test that the rank map gives every key its position in sorted order
+TEST_F(SparseTangoTreeTest, RankMapRanks) {
+    std::vector<uint64_t> keys = generate_random_keys(5000);
+    RankMap map(keys);
+    ASSERT_EQ(map.size(), 5000);
+
+    std::vector<uint64_t> sorted = keys;
+    std::sort(sorted.begin(), sorted.end());
+    for (int i = 0; i < 5000; ++i) {
+        ASSERT_EQ(map.rank(sorted[i]), i + 1);
+        ASSERT_EQ(map.key(i + 1), sorted[i]);
+    }
+    EXPECT_EQ(map.rank(sorted[0] - 1), 0);
+}
+
+// Test duplicates and tiny sets
+TEST_F(SparseTangoTreeTest, RankMapCornerCases) {
+    RankMap empty(std::vector<uint64_t>{});
+    EXPECT_EQ(empty.rank(1), 0);
+
+    RankMap map(std::vector<uint64_t>{42, 7, 42, 7});
+    EXPECT_EQ(map.size(), 2);
+    EXPECT_EQ(map.rank(7), 1);
+    EXPECT_EQ(map.rank(42), 2);
+    EXPECT_EQ(map.rank(8), 0);
+}
+
+// Test membership through the implicit tree
+TEST_F(SparseTangoTreeTest, ContainsSparseKeys) {
+    std::vector<uint64_t> keys = generate_random_keys(2000);
+    SparseTangoTree tree(keys);
+    for (uint64_t key : keys) {
+        ASSERT_TRUE(tree.contains(key)) << "Failed to find key: " << key;
+        ASSERT_FALSE(tree.contains(key + 1)) << "Found absent key: " << key + 1;
+    }
+}
@@ -0,0 +1,79 @@
+#include <gtest/gtest.h>
+#include <random>
+#include <set>
+#include <string>
+#include <vector>
+#include "StringTangoTree.h"
+
+// Test that prefixes keep the string order
+TEST(StringTangoTreeTest, PrefixOrder) {
+    EXPECT_LT(normalizedPrefix("abc"), normalizedPrefix("abd"));
+    EXPECT_LT(normalizedPrefix("ab"), normalizedPrefix("abc"));
+    EXPECT_LT(normalizedPrefix("\x7f"), normalizedPrefix("\x80"));
+    EXPECT_EQ(normalizedPrefix("https://a"), normalizedPrefix("https://b"));
+    EXPECT_LT(normalizedPrefix("https://a", 8), normalizedPrefix("https://b", 8));
+    EXPECT_EQ(normalizedPrefix("https://", 8), 0u);
+}
+
+// Test membership with keys sharing long prefixes
+TEST(StringTangoTreeTest, ContainsUrlKeys) {
+    std::vector<std::string> keys;
+    for (int i = 0; i < 1000; ++i) keys.push_back("https://example.com/page/" + std::to_string(i));
+    keys.push_back("a");
+    keys.push_back(std::string("a\0", 2));
+    keys.push_back("");
+    StringTangoTree tree(keys);
+    EXPECT_EQ(tree.size(), 1003);
+
+    for (const std::string &key : keys) {
+        ASSERT_TRUE(tree.contains(key)) << "Failed to find key: " << key;
+    }
+    EXPECT_FALSE(tree.contains("https://example.com/page/1000"));
+    EXPECT_FALSE(tree.contains("https://example.com/"));
+    EXPECT_FALSE(tree.contains("b"));
+    EXPECT_FALSE(tree.contains(std::string("a\0\0", 3)));
+}
+
+// Test that the prefixes skip the bytes shared by every key
+TEST(StringTangoTreeTest, CommonPrefixSkipped) {
+    std::vector<std::string> keys;
+    for (int i = 0; i < 1000; ++i) keys.push_back("https://example.com/page/" + std::to_string(i));
+    StringTangoTree tree(keys);
+    EXPECT_EQ(tree.commonPrefix(), "https://example.com/page/");
+
+    for (const std::string &key : keys) {
+        ASSERT_TRUE(tree.contains(key)) << "Failed to find key: " << key;
+    }
+    EXPECT_FALSE(tree.contains("https://example.com/page/"));
+    EXPECT_FALSE(tree.contains("https://example.com/page/1000"));
+    EXPECT_FALSE(tree.contains("https://example.com/pag"));
+    EXPECT_FALSE(tree.contains("http://example.com/page/1"));
+    EXPECT_FALSE(tree.contains(""));
+
+    StringTangoTree single({"https://example.com/"});
+    EXPECT_EQ(single.commonPrefix(), "https://example.com/");
+    EXPECT_TRUE(single.contains("https://example.com/"));
+    EXPECT_FALSE(single.contains("https://example.com/a"));
+    StringTangoTree empty({});
+    EXPECT_FALSE(empty.contains(""));
+}
+
+// Test membership against a sorted set, with keys long enough to tie on their prefixes and repeated searches
+TEST(StringTangoTreeTest, ContainsAgainstSet) {
+    std::mt19937 g(3);
+    auto random_key = [&g]() {
+        std::string key = "k/";
+        for (int i = 0, m = g() % 14; i < m; ++i) key.push_back("ab"[g() % 2]);
+        return key;
+    };
+    std::vector<std::string> keys;
+    for (int i = 0; i < 3000; ++i) keys.push_back(random_key());
+    std::set<std::string> set(keys.begin(), keys.end());
+    StringTangoTree tree(keys);
+    EXPECT_EQ(tree.size(), (int)set.size());
+
+    for (int q = 0; q < 20000; ++q) {
+        std::string key = q % 3 == 0 ? keys[g() % 16] : random_key();     // a few hot keys among random ones.
+        ASSERT_EQ(tree.contains(key), set.count(key) > 0) << "Wrong result for key: " << key;
+    }
+}
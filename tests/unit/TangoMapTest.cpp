@@ -0,0 +1,66 @@
+#include <gtest/gtest.h>
+#include <algorithm>
+#include <climits>
+#include <map>
+#include <random>
+#include <vector>
+#include "TangoMap.h"
+
+// A non commutative monoid: the value of the largest key in the range
+const Monoid LastMonoid = {LLONG_MIN, [](long long a, long long b) { return b == LLONG_MIN ? a : b; }};
+
+// Helper to fold the reference map over [lo, hi]
+long long fold(const std::map<int, long long> &ref, int lo, int hi, const Monoid &m) {
+    long long acc = m.identity;
+    for (auto it = ref.lower_bound(lo); it != ref.end() && it->first <= hi; ++it)
+        acc = m.combine(acc, it->second);
+    return acc;
+}
+
+// Test aggregates over the initial entries
+TEST(TangoMapTest, SumOverEntries) {
+    std::vector<std::pair<int, long long>> entries;
+    for (int key = 1; key <= 100; ++key)
+        entries.push_back({key, key});
+    TangoMap map(entries, SumMonoid);
+
+    EXPECT_EQ(map.size(), 100);
+    EXPECT_EQ(map.aggregate(1, 100), 5050);
+    EXPECT_EQ(map.aggregate(10, 20), 165);
+    EXPECT_EQ(map.aggregate(-5, 0), 0);
+    EXPECT_EQ(map.aggregate(50, 40), 0);
+
+    long long value = 0;
+    EXPECT_TRUE(map.get(42, value));
+    EXPECT_EQ(value, 42);
+    EXPECT_FALSE(map.get(101, value));
+}
+
+// Test aggregates against a reference map through puts and erases
+TEST(TangoMapTest, RandomUpdates) {
+    std::mt19937 g(11);
+    for (const Monoid *m : {&SumMonoid, &MaxMonoid, &MinMonoid, &LastMonoid}) {
+        TangoMap map(*m);
+        std::map<int, long long> ref;
+        for (int op = 0; op < 5000; ++op) {
+            int key = g() % 1000;
+            int c = g() % 4;
+            if (c == 0) {
+                long long value = (long long)(g() % 2001) - 1000;
+                ASSERT_EQ(map.put(key, value), ref.count(key) == 0);
+                ref[key] = value;
+            } else if (c == 1) {
+                ASSERT_EQ(map.erase(key), ref.erase(key) == 1);
+            } else {
+                int hi = key + g() % 200;
+                ASSERT_EQ(map.aggregate(key, hi), fold(ref, key, hi, *m)) << "Wrong aggregate for range: " << key << ' ' << hi;
+            }
+        }
+        ASSERT_EQ(map.size(), (int)ref.size());
+        for (auto [key, value] : ref) {
+            long long found = 0;
+            ASSERT_TRUE(map.get(key, found));
+            ASSERT_EQ(found, value);
+        }
+    }
+}
@@ -0,0 +1,84 @@
+#include <gtest/gtest.h>
+#include <random>
+#include <vector>
+#include "TangoPool.h"
+
+// Helper to build the key set of a tenant: the multiples of (id % 5 + 1) up to n
+std::vector<int> tenant_keys(int id, int n) {
+    std::vector<int> keys;
+    for (int key = 1; key <= n; ++key)
+        if (key % (id % 5 + 1) == 0) keys.push_back(key);
+    return keys;
+}
+
+// Test many small trees created and searched together
+TEST(TangoPoolTest, ManySmallTrees) {
+    TangoPool pool;
+    std::vector<std::vector<int>> keySets;
+    for (int t = 0; t < 2000; ++t)
+        keySets.push_back(tenant_keys(t, t % 100));
+    std::vector<int> ids = pool.createBulk(keySets);
+    EXPECT_EQ(pool.count(), 2000);
+
+    std::mt19937 g(5);
+    for (int q = 0; q < 100000; ++q) {
+        int t = g() % 2000, key = g() % 102;
+        bool expected = key >= 1 && key <= t % 100 && key % (t % 5 + 1) == 0;
+        ASSERT_EQ(pool.contains(ids[t], key), expected) << "Wrong result for tree " << t << " and key " << key;
+    }
+    for (int t = 0; t < 2000; ++t)
+        ASSERT_EQ(pool.size(ids[t]), (int)keySets[t].size());
+}
+
+// Test that destroyed trees give their ids and blocks back
+TEST(TangoPoolTest, DestroyAndReuse) {
+    TangoPool pool;
+    std::vector<int> keys = tenant_keys(0, 40);
+    std::vector<int> ids;
+    for (int t = 0; t < 100; ++t)
+        ids.push_back(pool.create(keys.data(), keys.size()));
+
+    pool.destroyBulk(std::vector<int>(ids.begin(), ids.begin() + 50));
+    EXPECT_EQ(pool.count(), 50);
+
+    std::vector<int> other = tenant_keys(1, 39);
+    int id = pool.create(other.data(), other.size());
+    EXPECT_LT(id, 50);
+    for (int key = 0; key <= 41; ++key) {
+        ASSERT_EQ(pool.contains(id, key), key >= 1 && key <= 39 && key % 2 == 0);
+        ASSERT_EQ(pool.contains(ids[99], key), key >= 1 && key <= 40);
+    }
+
+    // destroying a free id again does not hand it out twice.
+    pool.destroy(ids[99]);
+    pool.destroy(ids[99]);
+    EXPECT_EQ(pool.count(), 50);
+    int a = pool.create(keys.data(), keys.size());
+    int b = pool.create(keys.data(), keys.size());
+    EXPECT_NE(a, b);
+    EXPECT_EQ(pool.count(), 52);
+
+    pool.clear();
+    EXPECT_EQ(pool.count(), 0);
+    EXPECT_EQ(pool.create(nullptr, 0), 0);
+    EXPECT_FALSE(pool.contains(0, 1));
+}
+
+// Test a pool whose slab size comes from the default configuration
+TEST(TangoPoolTest, ConfiguredSlabSize) {
+    TangoConfig saved = TangoTree::defaultConfig();
+    TangoConfig config = saved;
+    config.slabBytes = 1;     // every block gets a slab of its own.
+    TangoTree::setDefaultConfig(config);
+    TangoPool pool;
+    TangoTree::setDefaultConfig(saved);
+
+    std::vector<int> ids;
+    for (int t = 0; t < 20; ++t) {
+        std::vector<int> keys = tenant_keys(t, 10 + t);
+        ids.push_back(pool.create(keys.data(), keys.size()));
+    }
+    for (int t = 0; t < 20; ++t)
+        for (int key = 0; key <= 31; ++key)
+            ASSERT_EQ(pool.contains(ids[t], key), key >= 1 && key <= 10 + t && key % (t % 5 + 1) == 0);
+}
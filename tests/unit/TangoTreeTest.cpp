@@ -1,7 +1,9 @@
 #include <gtest/gtest.h>
 #include <vector>
 #include <algorithm>
+#include <fstream>
 #include <random>
+#include <string>
 #include "TangoTree.h"
 
 class TangoTreeTest : public ::testing::Test {
@@ -18,6 +20,24 @@ protected:
     }
 };
 
+// Helper tree exposing its root, to check the shape left by the adaptive operations
+class InspectedTangoTree : public TangoTree {
+public:
+    using TangoTree::TangoTree;
+
+    // Check if the key is in the root auxiliary tree, the root preferred path
+    bool inRootPath(int key) const {
+        for (Node *h = root; h != Node::nil && !h->isExternal; h = key < h->key ? h->left : h->right)
+            if (h->key == key) return true;
+        return false;
+    }
+
+    // Check if the root preferred path is the root node alone, as built by the constructors
+    bool rootPathIsSingleNode() const {
+        return root != Node::nil && (root->left == Node::nil || root->left->isExternal) && (root->right == Node::nil || root->right->isExternal);
+    }
+};
+
 // Test if a tree of size 1 works correctly
 TEST_F(TangoTreeTest, SingleElementTree) {
     TangoTree tree(1);
@@ -52,4 +72,682 @@ TEST_F(TangoTreeTest, MassiveRandomStressTest) {
         // Every key within [1, N] must be found
         ASSERT_TRUE(tree.contains(key)) << "Failed to find key: " << key;
     }
-}
\ No newline at end of file
+}
+// Test a monotone scan with the finger mode on
+TEST_F(TangoTreeTest, FingerModeSequentialScan) {
+    int n = 1000;
+    TangoTree tree(n);
+    tree.setFingerMode(true);
+    for (int key = 1; key <= n; ++key)
+        ASSERT_TRUE(tree.contains(key)) << "Failed to find key: " << key;
+    EXPECT_FALSE(tree.contains(0));
+    EXPECT_FALSE(tree.contains(n + 1));
+    for (int key = n; key >= 1; --key)
+        ASSERT_TRUE(tree.contains(key)) << "Failed to find key: " << key;
+}
+
+// Test the finger neighbours on the reference tree of 1..7 (4 at the root, 2 and 6 below it)
+TEST_F(TangoTreeTest, AccessNearHandle) {
+    TangoTree tree(7);
+    Finger handle;
+    EXPECT_FALSE(tree.accessNear(handle, 8));
+    EXPECT_FALSE(handle.isSet);
+
+    EXPECT_TRUE(tree.accessNear(handle, 3));
+    EXPECT_EQ(handle.key, 3);
+    EXPECT_EQ(handle.prev, 2);
+    EXPECT_EQ(handle.next, 4);
+
+    EXPECT_TRUE(tree.accessNear(handle, 4));   // resolved by the handle
+    EXPECT_EQ(handle.key, 3);
+
+    handle = Finger();                         // 7 is in the subtree searched from 3, which keeps the handle
+    EXPECT_TRUE(tree.accessNear(handle, 7));
+    EXPECT_EQ(handle.key, 7);
+    EXPECT_EQ(handle.prev, 6);
+    EXPECT_EQ(handle.next, 7);                 // no greater ancestor
+}
+
+// Test that keys near a handle are searched from the subtree of its ancestor three levels up, on the reference tree of
+// 1..1023 (512 at the root, 8 the ancestor of 1 holding 1..15)
+TEST_F(TangoTreeTest, AccessNearSubtree) {
+    TangoTree tree(1023);
+    Finger handle;
+    EXPECT_TRUE(tree.accessNear(handle, 1));
+    EXPECT_EQ(handle.prev, 1);                 // no smaller ancestor
+    EXPECT_EQ(handle.next, 2);
+
+    EXPECT_TRUE(tree.accessNear(handle, 5));   // found in the subtree, the handle stays
+    EXPECT_TRUE(tree.accessNear(handle, 15));
+    EXPECT_FALSE(tree.accessNear(handle, 0));
+    EXPECT_EQ(handle.key, 1);
+
+    EXPECT_TRUE(tree.accessNear(handle, 16));  // outside the subtree, searched from the root
+    EXPECT_EQ(handle.key, 16);
+    EXPECT_TRUE(tree.erase(20));
+    EXPECT_TRUE(tree.accessNear(handle, 21));  // the erase changed the tree, searched from the root
+    EXPECT_EQ(handle.key, 21);
+    EXPECT_FALSE(tree.accessNear(handle, 20));
+    EXPECT_TRUE(tree.accessNear(handle, 19));
+    EXPECT_EQ(handle.key, 21);
+}
+
+// Test that a handle set before an erase does not answer for the erased keys
+TEST_F(TangoTreeTest, AccessNearAfterErase) {
+    TangoTree tree(100);
+    Finger handle;
+    EXPECT_TRUE(tree.accessNear(handle, 50));
+    EXPECT_TRUE(tree.erase(50));
+    EXPECT_FALSE(tree.contains(50));
+    EXPECT_FALSE(tree.accessNear(handle, 50));
+
+    EXPECT_TRUE(tree.accessNear(handle, 2));
+    EXPECT_EQ(handle.prev, 1);
+    EXPECT_EQ(tree.popFront(), 1);
+    EXPECT_FALSE(tree.accessNear(handle, 1));
+    EXPECT_TRUE(tree.accessNear(handle, 2));
+    EXPECT_TRUE(tree.accessNear(handle, 3));
+}
+
+// Test interleaved sequential streams with one finger per stream
+TEST_F(TangoTreeTest, MultiFingerInterleavedStreams) {
+    int n = 3000;
+    TangoTree tree(n);
+    tree.setFingerCount(3);
+    for (int i = 1; i <= 1000; ++i) {
+        ASSERT_TRUE(tree.contains(i)) << "Failed to find key: " << i;
+        ASSERT_TRUE(tree.contains(1000 + i)) << "Failed to find key: " << 1000 + i;
+        ASSERT_TRUE(tree.contains(n + 1 - i)) << "Failed to find key: " << n + 1 - i;
+        ASSERT_FALSE(tree.contains(n + i));
+    }
+    tree.setFingerCount(0);
+    EXPECT_TRUE(tree.contains(1500));
+}
+
+// Test the finger mode against a sorted set, through scans, random keys, inserts and erases
+TEST_F(TangoTreeTest, FingerModeAgainstSet) {
+    int n = 4000;
+    TangoTree tree(n);
+    tree.setFingerCount(2);
+    tree.setColdAge(32);     // the finger searches stop at the cold stubs.
+    std::vector<int> keys;
+    for (int key = 1; key <= n; ++key)
+        keys.push_back(key);
+    std::mt19937 g(5);
+    int scan = 1;
+    for (int q = 0; q < 40000; ++q) {
+        int key = g() % 4 == 0 ? (int)(g() % (n + 2)) : scan++ % (n + 2);
+        switch (g() % 16) {
+        case 0:
+            tree.insert(key);
+            if (!std::binary_search(keys.begin(), keys.end(), key))
+                keys.insert(std::lower_bound(keys.begin(), keys.end(), key), key);
+            break;
+        case 1:
+            tree.erase(key);
+            if (std::binary_search(keys.begin(), keys.end(), key))
+                keys.erase(std::lower_bound(keys.begin(), keys.end(), key));
+            break;
+        case 2:
+            tree.compress(0);
+            break;
+        default:
+            ASSERT_EQ(tree.contains(key), std::binary_search(keys.begin(), keys.end(), key)) << "Wrong result for key: " << key;
+        }
+    }
+}
+
+// Test insert and erase on a tree built empty
+TEST_F(TangoTreeTest, InsertAndErase) {
+    TangoTree tree(0);
+    EXPECT_FALSE(tree.contains(5));
+    EXPECT_FALSE(tree.erase(5));
+
+    std::vector<int> keys = generate_random_keys(500);
+    for (int key : keys) {
+        EXPECT_TRUE(tree.insert(2 * key));
+        EXPECT_FALSE(tree.insert(2 * key));
+    }
+    for (int key = -1; key <= 1001; ++key)
+        ASSERT_EQ(tree.contains(key), key > 0 && key % 2 == 0) << "Wrong result for key: " << key;
+
+    for (int key : keys) {
+        if (key % 3 == 0) {
+            EXPECT_TRUE(tree.erase(2 * key));
+        }
+    }
+    for (int key : keys)
+        ASSERT_EQ(tree.contains(2 * key), key % 3 != 0) << "Wrong result for key: " << 2 * key;
+
+    for (int key : keys)
+        tree.erase(2 * key);
+    EXPECT_FALSE(tree.contains(0));
+    EXPECT_TRUE(tree.insert(0));
+    EXPECT_TRUE(tree.contains(0));
+}
+
+// Test the result cache consistency under insert and erase
+TEST_F(TangoTreeTest, CacheInvalidation) {
+    int n = 100;
+    TangoTree tree(n);
+    tree.setCacheSize(4);
+    for (int round = 0; round < 3; ++round) {
+        EXPECT_TRUE(tree.contains(50));
+        EXPECT_FALSE(tree.contains(n + 1));
+    }
+    EXPECT_TRUE(tree.erase(50));
+    EXPECT_FALSE(tree.contains(50));
+    EXPECT_TRUE(tree.insert(n + 1));
+    EXPECT_TRUE(tree.contains(n + 1));
+    EXPECT_TRUE(tree.insert(50));
+    EXPECT_TRUE(tree.contains(50));
+
+    std::vector<int> keys = generate_random_keys(n);
+    for (int key : keys)
+        ASSERT_TRUE(tree.contains(key)) << "Failed to find key: " << key;
+}
+
+// Test the negative lookup filter on a sparse key set
+TEST_F(TangoTreeTest, NegativeLookupFilter) {
+    TangoTree tree(0);
+    for (int key = 0; key < 2000; key += 7)
+        tree.insert(key);
+    tree.setFilter(10);
+    for (int key = -10; key < 2010; ++key)
+        ASSERT_EQ(tree.contains(key), key >= 0 && key < 2000 && key % 7 == 0) << "Wrong result for key: " << key;
+
+    for (int key = 1; key < 2000; key += 7)   // grows past the filter size
+        tree.insert(key);
+    tree.erase(0);
+    for (int key = -10; key < 2010; ++key)
+        ASSERT_EQ(tree.contains(key), key > 0 && key < 2000 && (key % 7 == 0 || key % 7 == 1)) << "Wrong result for key: " << key;
+}
+
+// Test a tree over an arbitrary sorted key set
+TEST_F(TangoTreeTest, SortedKeySetConstructor) {
+    std::vector<int> keys;
+    for (int key = -300; key <= 300; key += 3)
+        keys.push_back(key);
+    TangoTree tree(keys);
+    for (int key = -310; key <= 310; ++key)
+        ASSERT_EQ(tree.contains(key), key >= -300 && key <= 300 && key % 3 == 0) << "Wrong result for key: " << key;
+}
+
+// Test freezing into the static layout and thawing back
+TEST_F(TangoTreeTest, FreezeAndThaw) {
+    int n = 1000;
+    TangoTree tree(n);
+    std::vector<int> keys = generate_random_keys(n);
+    for (int i = 0; i < n / 2; ++i)
+        tree.contains(keys[i]);
+    tree.erase(keys[0]);
+
+    tree.freeze();
+    EXPECT_TRUE(tree.frozen());
+    for (int key = 0; key <= n + 1; ++key)
+        ASSERT_EQ(tree.contains(key), key >= 1 && key <= n && key != keys[0]) << "Wrong result for key: " << key;
+
+    tree.thaw();
+    EXPECT_FALSE(tree.frozen());
+    for (int key : keys)
+        ASSERT_EQ(tree.contains(key), key != keys[0]) << "Wrong result for key: " << key;
+
+    tree.freeze();
+    tree.setFilter(10);     // built from the frozen layout.
+    for (int key = 0; key <= n + 1; ++key)
+        ASSERT_EQ(tree.contains(key), key >= 1 && key <= n && key != keys[0]) << "Wrong result for key: " << key;
+    tree.thaw();
+    for (int key : keys)
+        ASSERT_EQ(tree.contains(key), key != keys[0]) << "Wrong result for key: " << key;
+
+    tree.freeze();
+    EXPECT_TRUE(tree.insert(keys[0]));   // thaws the tree
+    EXPECT_FALSE(tree.frozen());
+    EXPECT_TRUE(tree.contains(keys[0]));
+}
+
+// Test rank and select against the sorted keys, through inserts, erases and a freeze
+TEST_F(TangoTreeTest, RankAndSelect) {
+    int n = 1000;
+    TangoTree tree(n);
+    for (int key : generate_random_keys(n / 2))
+        tree.contains(key);
+    for (int key = 1; key <= n; key += 4)
+        tree.erase(key);
+    tree.insert(n + 10);
+
+    std::vector<int> keys;
+    for (int key = 1; key <= n; ++key)
+        if (key % 4 != 1) keys.push_back(key);
+    keys.push_back(n + 10);
+    ASSERT_EQ(tree.size(), (int)keys.size());
+
+    for (int pass = 0; pass < 2; ++pass) {
+        for (int i = 0; i < (int)keys.size(); ++i)
+            ASSERT_EQ(tree.select(i), keys[i]) << "Wrong key for rank: " << i;
+        for (int key = 0; key <= n + 11; ++key) {
+            int expected = std::lower_bound(keys.begin(), keys.end(), key) - keys.begin();
+            ASSERT_EQ(tree.rank(key), expected) << "Wrong rank for key: " << key;
+        }
+        tree.freeze();
+    }
+}
+
+// Test batch lookups with repeated and absent keys
+TEST_F(TangoTreeTest, ContainsBatch) {
+    int n = 1000;
+    TangoTree tree(n);
+    std::vector<int> keys = generate_random_keys(n);
+    keys.push_back(0);
+    keys.push_back(n + 1);
+    keys.push_back(keys[0]);
+
+    bool found[1003];
+    tree.containsBatch(keys.data(), keys.size(), found);
+    for (size_t i = 0; i < keys.size(); ++i)
+        ASSERT_EQ(found[i], keys[i] >= 1 && keys[i] <= n) << "Wrong result for key: " << keys[i];
+}
+
+// Test compressed cold subtrees, expanded back by searches, rank, select, insert and erase
+TEST_F(TangoTreeTest, ColdSubtrees) {
+    int n = 5000;
+    TangoTree tree(n);
+    for (int key = 1; key <= 100; ++key)
+        tree.contains(key);
+    EXPECT_GT(tree.compress(0), n / 2);
+    EXPECT_EQ(tree.compress(0), 0);
+
+    std::vector<int> keys;
+    for (int key = 1; key <= n; ++key)
+        keys.push_back(key);
+    tree.setColdAge(64);
+    std::mt19937 g(7);
+    for (int q = 0; q < 20000; ++q) {
+        int key = g() % (n + 2);
+        switch (g() % 8) {
+        case 0:
+            tree.insert(key);
+            if (!std::binary_search(keys.begin(), keys.end(), key))
+                keys.insert(std::lower_bound(keys.begin(), keys.end(), key), key);
+            break;
+        case 1:
+            tree.erase(key);
+            if (std::binary_search(keys.begin(), keys.end(), key))
+                keys.erase(std::lower_bound(keys.begin(), keys.end(), key));
+            break;
+        case 2:
+            ASSERT_EQ(tree.rank(key), std::lower_bound(keys.begin(), keys.end(), key) - keys.begin());
+            break;
+        case 3:
+            ASSERT_EQ(tree.select(key % keys.size()), keys[key % keys.size()]);
+            break;
+        default:
+            ASSERT_EQ(tree.contains(key), std::binary_search(keys.begin(), keys.end(), key)) << "Wrong result for key: " << key;
+        }
+    }
+    ASSERT_EQ(tree.size(), (int)keys.size());
+
+    tree.compress(0);
+    tree.freeze();
+    for (int key = 0; key <= n + 1; ++key)
+        ASSERT_EQ(tree.contains(key), std::binary_search(keys.begin(), keys.end(), key));
+}
+
+// Test that searches expand cold stubs one level at a time, with tombstones and forks sharing the stubs
+TEST_F(TangoTreeTest, ColdStubsExpandLazily) {
+    int n = 1 << 16;
+    TangoTree tree(n);
+    for (int key = 3; key <= n; key += 3)
+        tree.erase(key);
+    EXPECT_GT(tree.compress(0), n / 2);
+
+    TangoTree copy = tree.fork();
+    std::mt19937 g(11);
+    for (int q = 0; q < 2000; ++q) {
+        int key = g() % (n + 2);
+        ASSERT_EQ(tree.contains(key), key >= 1 && key <= n && key % 3 != 0) << "Wrong result for key: " << key;
+    }
+    copy.erase(1);
+    for (int key = 0; key <= n + 1; ++key)
+        ASSERT_EQ(copy.contains(key), key > 1 && key <= n && key % 3 != 0) << "Wrong result for key: " << key;
+    EXPECT_EQ(tree.rank(n + 1), n - n / 3);
+    EXPECT_EQ(tree.select(0), 1);
+    tree.compress(0);
+    EXPECT_EQ(tree.size(), n - n / 3);
+    EXPECT_TRUE(tree.contains(n - 2));
+}
+
+// Test that hinted keys keep their answers, with and without the cache
+TEST_F(TangoTreeTest, HintUpcomingKeys) {
+    int n = 1000;
+    InspectedTangoTree tree(n);
+    tree.erase(10);
+    std::vector<int> keys = {10, 500, n + 5, 3, 999, 0};
+    for (int pass = 0; pass < 2; ++pass) {
+        tree.contains(700);
+        EXPECT_FALSE(tree.inRootPath(10));
+        tree.hint(keys.data(), keys.size());
+        EXPECT_TRUE(tree.inRootPath(10));     // the first hinted key was accessed last.
+        EXPECT_TRUE(tree.inRootPath(500));
+        for (int key : keys)
+            ASSERT_EQ(tree.contains(key), key >= 1 && key <= n && key != 10) << "Wrong result for key: " << key;
+        tree.setCacheSize(16);
+    }
+    tree.insert(10);
+    EXPECT_TRUE(tree.contains(10));
+}
+
+// Helper to check the red-black invariants of a tree and return its black height
+int black_height(Node *h) {
+    if (h == Node::nil) return 0;
+    EXPECT_FALSE(h->isExternal);
+    EXPECT_NE(h->right->color, RED);
+    if (h->color == RED) {
+        EXPECT_NE(h->left->color, RED);
+    }
+    int left = black_height(h->left), right = black_height(h->right);
+    EXPECT_EQ(left, right);
+    EXPECT_EQ(h->size, h->left->size + h->right->size + 1);
+    return left + (h->color == BLACK ? 1 : 0);
+}
+
+// Test the conversions between a red-black tree and a Tango Tree
+TEST_F(TangoTreeTest, RedBlackTreeConversion) {
+    int n = 2000;
+    std::vector<int> keys = generate_random_keys(n);
+    Node *rbt = Node::nil;
+    for (int key : keys)
+        rbt = insert(rbt, 3 * key);
+    Node *six = search(rbt, 6).first;
+
+    TangoTree tree = TangoTree::fromRedBlackTree(rbt);
+    ASSERT_EQ(tree.size(), n);
+    for (int key = 0; key <= 3 * n + 1; ++key)
+        ASSERT_EQ(tree.contains(key), key % 3 == 0 && key > 0) << "Wrong result for key: " << key;
+    tree.erase(3);
+    tree.insert(4);
+
+    rbt = tree.toRedBlackTree();
+    EXPECT_EQ(tree.size(), 0);
+    EXPECT_FALSE(tree.contains(6));
+    black_height(rbt);
+    EXPECT_EQ(rbt->size, n);
+    EXPECT_EQ(search(rbt, 6).first, six);     // the nodes are reused.
+    for (int i = 0; i < n; ++i)
+        ASSERT_EQ(select(rbt, i)->key, i == 0 ? 4 : 3 * (i + 1)) << "Wrong key for rank: " << i;
+
+    tree.insert(7);
+    EXPECT_TRUE(tree.contains(7));
+    EXPECT_FALSE(tree.contains(4));
+    TangoTree back = TangoTree::fromRedBlackTree(rbt);
+    EXPECT_TRUE(back.contains(4));
+}
+
+// Test that forks evolve independently of the tree and of each other
+TEST_F(TangoTreeTest, ForkCopyOnWrite) {
+    int n = 3000;
+    TangoTree tree(n);
+    for (int key : generate_random_keys(n / 4))
+        tree.contains(key);
+    std::vector<int> all;
+    for (int key = 1; key <= n; ++key)
+        all.push_back(key);
+
+    TangoTree fork = tree.fork();
+    std::vector<std::vector<int>> keys = {all, all, all};
+    {
+        TangoTree nested = fork.fork();
+        std::mt19937 g(3);
+        TangoTree *trees[] = {&tree, &fork, &nested};
+        for (int q = 0; q < 30000; ++q) {
+            int t = g() % 3, key = g() % (n + 2);
+            std::vector<int> &ref = keys[t];
+            bool present = std::binary_search(ref.begin(), ref.end(), key);
+            switch (g() % 6) {
+            case 0:
+                trees[t]->insert(key);
+                if (!present)
+                    ref.insert(std::lower_bound(ref.begin(), ref.end(), key), key);
+                break;
+            case 1:
+                trees[t]->erase(key);
+                if (present)
+                    ref.erase(std::lower_bound(ref.begin(), ref.end(), key));
+                break;
+            case 2:
+                ASSERT_EQ(trees[t]->select(key % ref.size()), ref[key % ref.size()]);
+                break;
+            case 3:
+                if (q % 1000 == 0)
+                    trees[t]->compress(100);
+                break;
+            default:
+                ASSERT_EQ(trees[t]->contains(key), present) << "Wrong result in tree " << t << " for key: " << key;
+            }
+        }
+        for (int key = 0; key <= n + 1; ++key)
+            ASSERT_EQ(nested.contains(key), std::binary_search(keys[2].begin(), keys[2].end(), key));
+    }
+
+    tree.freeze();
+    for (int t = 0; t < 2; ++t) {
+        TangoTree &current = t == 0 ? tree : fork;
+        ASSERT_EQ(current.size(), (int)keys[t].size());
+        for (int key = 0; key <= n + 1; ++key)
+            ASSERT_EQ(current.contains(key), std::binary_search(keys[t].begin(), keys[t].end(), key));
+    }
+}
+
+// Test resetting the adaptation after a shift of the accessed keys
+TEST_F(TangoTreeTest, ResetAdaptation) {
+    int n = 4000;
+    InspectedTangoTree tree(n);
+    EXPECT_TRUE(tree.rootPathIsSingleNode());
+    for (int key = 1; key <= 200; ++key)
+        tree.contains(key);
+    tree.erase(5);
+    tree.insert(n + 7);
+    tree.compress(0);
+    EXPECT_FALSE(tree.rootPathIsSingleNode());
+    tree.resetAdaptation();
+    EXPECT_TRUE(tree.rootPathIsSingleNode());     // back to the constructor's configuration.
+
+    EXPECT_EQ(tree.size(), n);
+    for (int key = 0; key <= n + 8; ++key)
+        ASSERT_EQ(tree.contains(key), (key >= 1 && key <= n && key != 5) || key == n + 7) << "Wrong result for key: " << key;
+    EXPECT_EQ(tree.rank(n + 7), n - 1);
+    EXPECT_EQ(tree.select(4), 6);
+}
+
+// Test the biased auxiliary trees under a skewed access pattern with updates
+TEST_F(TangoTreeTest, BiasedAuxiliaryTrees) {
+    int n = 3000;
+    TangoTree tree(n);
+    tree.setBiased(true);
+    std::vector<int> keys;
+    for (int key = 1; key <= n; ++key)
+        keys.push_back(key);
+
+    std::mt19937 g(5);
+    for (int q = 0; q < 30000; ++q) {
+        int key = g() % 4 == 0 ? (int)(g() % (n + 2)) : (int)(g() % 16) * 100;
+        bool present = std::binary_search(keys.begin(), keys.end(), key);
+        switch (g() % 10) {
+        case 0:
+            tree.insert(key);
+            if (!present)
+                keys.insert(std::lower_bound(keys.begin(), keys.end(), key), key);
+            break;
+        case 1:
+            tree.erase(key);
+            if (present)
+                keys.erase(std::lower_bound(keys.begin(), keys.end(), key));
+            break;
+        case 2:
+            ASSERT_EQ(tree.rank(key), std::lower_bound(keys.begin(), keys.end(), key) - keys.begin());
+            break;
+        default:
+            ASSERT_EQ(tree.contains(key), present) << "Wrong result for key: " << key;
+        }
+    }
+    tree.setBiased(false);
+    for (int key = 0; key <= n + 1; ++key)
+        ASSERT_EQ(tree.contains(key), std::binary_search(keys.begin(), keys.end(), key));
+}
+
+// Test a sliding window of appended keys, with lookups and a fork in between
+TEST_F(TangoTreeTest, SlidingWindow) {
+    TangoTree tree(100);
+    int front = 1, back = 101;
+    for (int step = 0; step < 20000; ++step) {
+        ASSERT_TRUE(tree.pushBack(back++));
+        if (step % 3 != 0) {
+            ASSERT_EQ(tree.popFront(), front++);
+        }
+        if (step % 50 == 0) {
+            ASSERT_TRUE(tree.contains(front));
+            ASSERT_FALSE(tree.contains(front - 1));
+            ASSERT_EQ(tree.rank(back - 1), back - 1 - front);
+        }
+    }
+    EXPECT_EQ(tree.size(), back - front);
+    EXPECT_FALSE(tree.pushBack(back - 1));     // not above the max, so it is a regular insert.
+
+    TangoTree copy = tree.fork();
+    copy.pushBack(back);
+    EXPECT_EQ(copy.popFront(), front);
+    EXPECT_FALSE(tree.contains(back));
+    for (int key = front - 5; key <= back; ++key)
+        ASSERT_EQ(tree.contains(key), key >= front && key < back) << "Wrong result for key: " << key;
+}
+
+// Test sorted batch inserts, small ones between the keys and one larger than the tree
+TEST_F(TangoTreeTest, InsertBatch) {
+    int n = 2000;
+    std::vector<int> base;
+    for (int key = 1; key <= n; ++key)
+        base.push_back(10 * key);
+    TangoTree tree(base);
+    tree.erase(500);
+    tree.setFilter(10);     // built while 500 is erased.
+
+    std::vector<int> batch = {5, 500, 501, 502, 503, 504, 505, 506, 507, 508, 509, 510, 7001, 7002};
+    for (int key = 30001; key <= 30500; ++key)
+        batch.push_back(key);     // a long run in one gap.
+    EXPECT_EQ(tree.insertBatch(batch.data(), batch.size()), (int)batch.size() - 1);     // 510 is already in.
+    std::vector<int> keys = base;
+    keys.insert(keys.end(), batch.begin(), batch.end());
+    std::sort(keys.begin(), keys.end());
+    keys.erase(std::unique(keys.begin(), keys.end()), keys.end());
+    EXPECT_EQ(tree.size(), (int)keys.size());
+    for (int key = 0; key <= 10 * n + 1; ++key)
+        ASSERT_EQ(tree.contains(key), std::binary_search(keys.begin(), keys.end(), key)) << "Wrong result for key: " << key;
+
+    std::vector<int> large;
+    for (int key = 3; key <= 20 * n; key += 3)
+        large.push_back(key);
+    tree.insertBatch(large.data(), large.size());
+    keys.insert(keys.end(), large.begin(), large.end());
+    std::sort(keys.begin(), keys.end());
+    keys.erase(std::unique(keys.begin(), keys.end()), keys.end());
+    EXPECT_EQ(tree.size(), (int)keys.size());
+    EXPECT_EQ(tree.select(tree.size() - 1), keys.back());
+    for (int key = 0; key <= 20 * n + 1; ++key)
+        ASSERT_EQ(tree.contains(key), std::binary_search(keys.begin(), keys.end(), key)) << "Wrong result for key: " << key;
+}
+
+// Test the configuration file and the default configuration applied by the constructors
+TEST_F(TangoTreeTest, ConfigFile) {
+    TangoConfig config;
+    config.cacheSets = 512;
+    config.filterBits = 10;
+    config.fingers = 2;
+    config.coldAge = 1000;
+    config.biased = true;
+    config.parallelCutoff = 1 << 12;
+    config.slabBytes = 1 << 18;
+    std::string path = ::testing::TempDir() + "tango.conf";
+    ASSERT_TRUE(saveConfig(path.c_str(), config));
+
+    TangoConfig loaded;
+    ASSERT_TRUE(loadConfig(path.c_str(), loaded));
+    EXPECT_EQ(loaded.cacheSets, 512);
+    EXPECT_EQ(loaded.filterBits, 10);
+    EXPECT_EQ(loaded.fingers, 2);
+    EXPECT_EQ(loaded.coldAge, 1000u);
+    EXPECT_TRUE(loaded.biased);
+    EXPECT_EQ(loaded.parallelCutoff, (size_t)1 << 12);
+    EXPECT_EQ(loaded.slabBytes, (size_t)1 << 18);
+
+    // missing knobs keep their values, unknown ones are ignored and an invalid line leaves the configuration alone.
+    {
+        std::ofstream file(path);
+        file << "# partial\nfilterBits = 6   # comment\nprefetch = 8\n";
+    }
+    ASSERT_TRUE(loadConfig(path.c_str(), loaded));
+    EXPECT_EQ(loaded.filterBits, 6);
+    EXPECT_EQ(loaded.cacheSets, 512);
+    {
+        std::ofstream file(path);
+        file << "cacheSets = 64\nfilterBits = many\n";
+    }
+    EXPECT_FALSE(loadConfig(path.c_str(), loaded));
+    EXPECT_EQ(loaded.cacheSets, 512);
+    EXPECT_FALSE(loadConfig((path + ".missing").c_str(), loaded));
+
+    TangoConfig saved = TangoTree::defaultConfig();
+    TangoTree::setDefaultConfig(config);
+    EXPECT_EQ(parallelCutoff(), (size_t)1 << 12);
+    std::vector<int> keys;
+    for (int key = 0; key < 20000; key += 2)
+        keys.push_back(key);
+    TangoTree tree(keys);
+    for (int q = 0; q < 3; ++q)
+        for (int key = -1; key <= 20000; ++key)
+            ASSERT_EQ(tree.contains(key), key >= 0 && key % 2 == 0 && key < 20000) << "Wrong result for key: " << key;
+    TangoTree::setDefaultConfig(saved);
+    EXPECT_EQ(TangoTree::defaultConfig().cacheSets, saved.cacheSets);
+}
+
+// Test the pinned keys through accesses, erases and forks
+TEST_F(TangoTreeTest, PinnedKeys) {
+    int n = 100000;
+    TangoTree tree(n);
+    EXPECT_TRUE(tree.pin(1));
+    EXPECT_TRUE(tree.pin(n / 2));
+    EXPECT_TRUE(tree.pin(n));
+    EXPECT_TRUE(tree.pin(n));
+    EXPECT_FALSE(tree.pin(0));
+    EXPECT_FALSE(tree.pin(n + 1));
+
+    std::mt19937 g(3);
+    for (int q = 0; q < 20000; ++q) {
+        int key = g() % (n + 2);
+        ASSERT_EQ(tree.contains(key), key >= 1 && key <= n) << "Wrong result for key: " << key;
+        ASSERT_TRUE(tree.contains(n / 2));
+    }
+
+    TangoTree copy = tree.fork();
+    EXPECT_TRUE(tree.erase(n / 2));
+    EXPECT_FALSE(tree.contains(n / 2));
+    EXPECT_FALSE(tree.pin(n / 2));
+    EXPECT_FALSE(tree.unpin(n / 2));
+    EXPECT_TRUE(copy.contains(n / 2));
+
+    EXPECT_TRUE(tree.unpin(n));
+    EXPECT_FALSE(tree.unpin(n));
+    EXPECT_TRUE(tree.contains(n));
+    EXPECT_EQ(tree.popFront(), 1);
+    EXPECT_FALSE(tree.contains(1));
+    EXPECT_TRUE(tree.insert(1));
+    EXPECT_TRUE(tree.contains(1));
+    EXPECT_EQ(tree.size(), n - 1);
+    // converting the tree empties it, pins included.
+    EXPECT_TRUE(tree.pin(42));
+    Node *rbt = tree.toRedBlackTree();
+    EXPECT_EQ(tree.size(), 0);
+    EXPECT_FALSE(tree.contains(42));
+    EXPECT_FALSE(tree.contains(n));
+    TangoTree back = TangoTree::fromRedBlackTree(rbt);
+    EXPECT_TRUE(back.contains(42));
+}
@@ -0,0 +1,26 @@
+#include <gtest/gtest.h>
+#include "TangoTune.h"
+
+// Test that the calibration picks supported values and keeps the workload knobs
+TEST(TangoTuneTest, Calibrate) {
+    TangoConfig base;
+    base.fingers = 3;
+    base.coldAge = 500;
+    size_t cutoff = parallelCutoff();
+    size_t slab = TangoTree::defaultConfig().slabBytes;
+    TangoConfig config = calibrate(1 << 12, base);
+
+    EXPECT_TRUE(config.cacheSets == 0 || config.cacheSets == 256 || config.cacheSets == 2048 || config.cacheSets == 16384);
+    EXPECT_TRUE(config.filterBits == 0 || config.filterBits == 8 || config.filterBits == 12 || config.filterBits == 16);
+    EXPECT_TRUE(config.slabBytes == 1 << 14 || config.slabBytes == 1 << 16 || config.slabBytes == 1 << 18 || config.slabBytes == 1 << 20);
+    EXPECT_EQ(TangoTree::defaultConfig().slabBytes, slab);
+    EXPECT_EQ(config.fingers, 3);
+    EXPECT_EQ(config.coldAge, 500u);
+    EXPECT_FALSE(config.biased);
+    EXPECT_EQ(parallelCutoff(), cutoff);
+
+    TangoTree tree(1000);
+    tree.configure(config);
+    for (int key = 0; key <= 1001; ++key)
+        ASSERT_EQ(tree.contains(key), key >= 1 && key <= 1000) << "Wrong result for key: " << key;
+}
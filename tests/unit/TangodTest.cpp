@@ -0,0 +1,76 @@
+#include <gtest/gtest.h>
+#include <chrono>
+#include <csignal>
+#include <cstring>
+#include <future>
+#include <string>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <sys/wait.h>
+#include <thread>
+#include <unistd.h>
+#include <vector>
+
+// Helper to start a server over the keys 1 to n and connect to it
+int start_server(const std::string &path, int n, pid_t &pid) {
+    pid = fork();
+    if (pid == 0) {
+        std::string keys = std::to_string(n);
+        execl(TANGOD_PATH, TANGOD_PATH, path.c_str(), keys.c_str(), (char *)nullptr);
+        _exit(127);
+    }
+    sockaddr_un addr{};
+    addr.sun_family = AF_UNIX;
+    std::strcpy(addr.sun_path, path.c_str());
+    for (int attempt = 0; attempt < 500; ++attempt) {     // wait for the server to listen.
+        int fd = socket(AF_UNIX, SOCK_STREAM, 0);
+        if (connect(fd, (sockaddr *)&addr, sizeof(addr)) == 0)
+            return fd;
+        close(fd);
+        usleep(10000);
+    }
+    return -1;
+}
+
+// Test that every pipelined request is answered when the client half-closes right after sending
+TEST(TangodTest, PipelineThenHalfClose) {
+    std::string path = testing::TempDir() + "tangod.sock";
+    pid_t pid;
+    int fd = start_server(path, 1000, pid);
+    ASSERT_GE(fd, 0);
+
+    // the responses are read once every request is sent, so that they are still pending in the server when it reads the
+    // end of the stream. The reader starts anyway after a while, in case the server stopped reading on too much output.
+    int m = 1000000;
+    std::promise<void> sent;
+    std::thread writer([&] {
+        std::vector<char> requests(8 * m, 0);
+        for (int i = 0; i < m; ++i) {
+            int key = i % 1200;
+            requests[8 * i] = 1;     // contains on tree 0.
+            std::memcpy(&requests[8 * i + 4], &key, sizeof(int));
+        }
+        for (size_t k = 0; k < requests.size();) {
+            ssize_t w = send(fd, requests.data() + k, requests.size() - k, MSG_NOSIGNAL);
+            if (w <= 0)
+                break;
+            k += w;
+        }
+        shutdown(fd, SHUT_WR);
+        sent.set_value();
+    });
+    sent.get_future().wait_for(std::chrono::seconds(2));
+
+    std::vector<char> responses;
+    char buffer[1 << 16];
+    for (ssize_t r; (r = recv(fd, buffer, sizeof(buffer), 0)) > 0;)
+        responses.insert(responses.end(), buffer, buffer + r);
+    writer.join();
+    close(fd);
+    kill(pid, SIGTERM);
+    waitpid(pid, nullptr, 0);
+
+    ASSERT_EQ(responses.size(), (size_t)m);
+    for (int i = 0; i < m; ++i)
+        ASSERT_EQ(responses[i], (i % 1200 >= 1 && i % 1200 <= 1000) ? 1 : 0) << "Wrong response for request: " << i;
+}
@@ -0,0 +1,43 @@
+#include <gtest/gtest.h>
+#include <random>
+#include <vector>
+#include "TieredTangoTree.h"
+
+class TieredTangoTreeTest : public ::testing::Test {
+protected:
+    // Helper to generate the sorted keys 0, 3, 6, ..., 3(n - 1)
+    std::vector<int> generate_keys(int n) {
+        std::vector<int> keys(n);
+        for (int i = 0; i < n; ++i) keys[i] = 3 * i;
+        return keys;
+    }
+};
+
+// Test that every key is found before any tier update
+TEST_F(TieredTangoTreeTest, AllKeysCold) {
+    int n = 1000;
+    TieredTangoTree store(generate_keys(n), 16);
+    for (int key = -3; key < 3 * n + 3; ++key)
+        ASSERT_EQ(store.contains(key), key >= 0 && key < 3 * n && key % 3 == 0) << "Wrong result for key: " << key;
+    EXPECT_EQ(store.hotSize(), 0);
+}
+
+// Test that a skewed workload promotes its hot keys and keeps the answers right
+TEST_F(TieredTangoTreeTest, SkewedWorkloadPromotesHotKeys) {
+    int n = 10000;
+    int hotCapacity = 32;
+    TieredTangoTree store(generate_keys(n), hotCapacity, 1000);
+
+    std::mt19937 gen(42);
+    std::uniform_int_distribution<> hot(0, 19);
+    std::uniform_int_distribution<> any(0, 3 * n);
+    for (int i = 0; i < 20000; ++i) {
+        int key = i % 4 == 0 ? any(gen) : 3 * hot(gen);
+        ASSERT_EQ(store.contains(key), key % 3 == 0) << "Wrong result for key: " << key;
+    }
+    EXPECT_GE(store.hotSize(), 20);
+    EXPECT_LE(store.hotSize(), hotCapacity);
+
+    for (int key = 0; key < 3 * n; ++key)
+        ASSERT_EQ(store.contains(key), key % 3 == 0) << "Wrong result for key: " << key;
+}